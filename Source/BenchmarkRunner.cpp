@@ -0,0 +1,341 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Core/CoreEvents.h>
+#include <Urho3D/Core/ProcessUtils.h>
+#include <Urho3D/Container/Sort.h>
+#include <Urho3D/Engine/Engine.h>
+#include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/Physics/PhysicsEvents.h>
+#include <Urho3D/Physics/PhysicsWorld.h>
+#include <Urho3D/Resource/JSONFile.h>
+#include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/Resource/XMLFile.h>
+#include <Urho3D/Scene/Scene.h>
+
+#include "EntityIndex.h"
+#include "GameEventChannel.h"
+#include "LevelManager.h"
+#include "PlayerInput.h"
+#include "BenchmarkRunner.h"
+
+/// Return the value at the fraction of a sorted sample set.
+static float GetPercentile(const PODVector<float>& sorted, float fraction)
+{
+    if(sorted.Empty())
+        return 0.0f;
+
+    return sorted[(unsigned)(fraction * (sorted.Size() - 1) + 0.5f)];
+}
+
+JSONValue BenchmarkRunner::GetTimingSummary(const PODVector<float>& samples)
+{
+    PODVector<float> sorted(samples);
+    Sort(sorted.Begin(), sorted.End());
+
+    float total = 0.0f;
+    for(unsigned i = 0; i < sorted.Size(); ++i)
+    {
+        total += sorted[i];
+    }
+
+    JSONValue summary;
+    summary.Set("count", sorted.Size());
+    summary.Set("mean", sorted.Empty() ? 0.0f : total / sorted.Size());
+    summary.Set("p50", GetPercentile(sorted, 0.5f));
+    summary.Set("p90", GetPercentile(sorted, 0.9f));
+    summary.Set("p95", GetPercentile(sorted, 0.95f));
+    summary.Set("p99", GetPercentile(sorted, 0.99f));
+    summary.Set("max", sorted.Empty() ? 0.0f : sorted.Back());
+
+    return summary;
+}
+
+BenchmarkRunner::BenchmarkRunner(Context *context) : Object(context)
+, seed_(1)
+, duration_(60.0f)
+, timeStep_(1.0f / 60.0f)
+, yawInput_(4)
+, pitchInput_(0)
+, fireInterval_(0.2f)
+, droneBucket_(100)
+, frameBudget_(1000.0f / 60.0f)
+, elapsedTime_(0.0f)
+, fireTimer_(0.0f)
+, currentDrones_(0)
+, peakDrones_(0)
+, peakSceneNodes_(0)
+, dronesDestroyed_(0)
+, running_(false)
+{
+
+}
+
+bool BenchmarkRunner::LoadScenario(const String &scenario)
+{
+    String fileName = scenario.EndsWith(".xml") ? scenario : "Benchmarks/" + scenario + ".xml";
+
+    auto* file = GetSubsystem<ResourceCache>()->GetResource<XMLFile>(fileName);
+    if(!file)
+        return false;
+
+    XMLElement root = file->GetRoot("benchmark");
+    if(!root)
+    {
+        URHO3D_LOGERROR("Benchmark scenario " + fileName + " has no benchmark element");
+        return false;
+    }
+
+    scenarioName_ = GetFileName(fileName);
+
+    if(root.HasAttribute("seed"))
+        seed_ = root.GetUInt("seed");
+    if(root.HasAttribute("duration"))
+        duration_ = root.GetFloat("duration");
+    if(root.HasAttribute("timeStep"))
+        timeStep_ = Max(root.GetFloat("timeStep"), M_EPSILON);
+
+    //level settings are passed on to the level script, which keeps its own defaults for missing ones
+    XMLElement levelElem = root.GetChild("level");
+    if(levelElem)
+    {
+        if(levelElem.HasAttribute("waves"))
+            levelSettings_["WaveSchedule"] = levelElem.GetAttribute("waves");
+        if(levelElem.HasAttribute("invulnerable"))
+            levelSettings_["Invulnerable"] = levelElem.GetBool("invulnerable");
+    }
+
+    XMLElement scalingElem = root.GetChild("scaling");
+    if(scalingElem)
+    {
+        if(scalingElem.HasAttribute("droneBucket"))
+            droneBucket_ = Max(scalingElem.GetUInt("droneBucket"), 1U);
+        if(scalingElem.HasAttribute("frameBudget"))
+            frameBudget_ = scalingElem.GetFloat("frameBudget");
+    }
+
+    XMLElement inputElem = root.GetChild("input");
+    if(inputElem)
+    {
+        if(inputElem.HasAttribute("yaw"))
+            yawInput_ = inputElem.GetInt("yaw");
+        if(inputElem.HasAttribute("pitch"))
+            pitchInput_ = inputElem.GetInt("pitch");
+        if(inputElem.HasAttribute("fireInterval"))
+            fireInterval_ = inputElem.GetFloat("fireInterval");
+    }
+
+    return true;
+}
+
+void BenchmarkRunner::SetScene(Scene *scene)
+{
+    scene_ = scene;
+
+    auto* physicsWorld = scene ? scene->GetComponent<PhysicsWorld>() : nullptr;
+    if(physicsWorld)
+    {
+        SubscribeToEvent(physicsWorld, E_PHYSICSPRESTEP, URHO3D_HANDLER(BenchmarkRunner, HandlePhysicsPreStep));
+        SubscribeToEvent(physicsWorld, E_PHYSICSPOSTSTEP, URHO3D_HANDLER(BenchmarkRunner, HandlePhysicsPostStep));
+    }
+}
+
+void BenchmarkRunner::Run(LevelManager *levelManager)
+{
+    levelManager_ = levelManager;
+
+    //frames are neither limited nor paused, and every frame advances the level by the scenario timestep
+    auto* engine = GetSubsystem<Engine>();
+    engine->SetMaxFps(0);
+    engine->SetMaxInactiveFps(0);
+    engine->SetPauseMinimized(false);
+    engine->SetNextTimeStep(timeStep_);
+
+    SubscribeToEvent(E_BEGINFRAME, URHO3D_HANDLER(BenchmarkRunner, HandleBeginFrame));
+    SubscribeToEvent(E_ENDFRAME, URHO3D_HANDLER(BenchmarkRunner, HandleEndFrame));
+    SubscribeToEvent(E_UPDATE, URHO3D_HANDLER(BenchmarkRunner, HandleUpdate));
+    GetSubsystem<GameEventChannel>()->Subscribe(this, &BenchmarkRunner::HandleDronesDestroyed);
+
+    URHO3D_LOGINFO("Running benchmark " + scenarioName_ + " for " + String(duration_) + " s");
+
+    levelManager->StartBenchmark(levelSettings_);
+    running_ = true;
+}
+
+void BenchmarkRunner::HandleBeginFrame(StringHash eventType, VariantMap &eventData)
+{
+    frameTimer_.Reset();
+}
+
+void BenchmarkRunner::HandleEndFrame(StringHash eventType, VariantMap &eventData)
+{
+    if(!running_)
+        return;
+
+    frameTimes_.Push(frameTimer_.GetUSec(false) / 1000.0f);
+    elapsedTime_ += timeStep_;
+    SampleEntities();
+    frameDrones_.Push(currentDrones_);
+
+    if(elapsedTime_ >= duration_)
+    {
+        running_ = false;
+        WriteReport();
+        GetSubsystem<Engine>()->Exit();
+        return;
+    }
+
+    GetSubsystem<Engine>()->SetNextTimeStep(timeStep_);
+}
+
+void BenchmarkRunner::HandleUpdate(StringHash eventType, VariantMap &eventData)
+{
+    if(!running_ || !levelManager_)
+        return;
+
+    //turn continuously, as if the mouse kept moving
+    GetSubsystem<PlayerInput>()->AddLookDelta(yawInput_, pitchInput_);
+
+    if(fireInterval_ <= 0.0f)
+        return;
+
+    fireTimer_ += timeStep_;
+    while(fireTimer_ >= fireInterval_)
+    {
+        GetSubsystem<GameEventChannel>()->Post(ActivateWeapon::Data());
+        fireTimer_ -= fireInterval_;
+    }
+}
+
+void BenchmarkRunner::HandlePhysicsPreStep(StringHash eventType, VariantMap &eventData)
+{
+    stepTimer_.Reset();
+}
+
+void BenchmarkRunner::HandlePhysicsPostStep(StringHash eventType, VariantMap &eventData)
+{
+    if(running_)
+    {
+        stepTimes_.Push(stepTimer_.GetUSec(false) / 1000.0f);
+    }
+}
+
+void BenchmarkRunner::HandleDronesDestroyed(const DroneDestroyed::Data *events, unsigned count)
+{
+    if(running_)
+    {
+        dronesDestroyed_ += count;
+    }
+}
+
+void BenchmarkRunner::SampleEntities()
+{
+    if(!scene_)
+        return;
+
+    auto* entityIndex = scene_->GetComponent<EntityIndex>();
+    if(entityIndex)
+    {
+        currentDrones_ = entityIndex->GetTaggedCount("drone");
+        peakDrones_ = Max(peakDrones_, currentDrones_);
+    }
+
+    peakSceneNodes_ = Max(peakSceneNodes_, scene_->GetNumChildren(true));
+}
+
+JSONValue BenchmarkRunner::GetScalingSummary() const
+{
+    //frame times grouped by the number of live drones
+    Vector<PODVector<float> > buckets;
+    for(unsigned i = 0; i < frameTimes_.Size(); ++i)
+    {
+        unsigned bucket = frameDrones_[i] / droneBucket_;
+        if(bucket >= buckets.Size())
+            buckets.Resize(bucket + 1);
+
+        buckets[bucket].Push(frameTimes_[i]);
+    }
+
+    JSONArray curve;
+    int breakdownDrones = -1;
+    for(unsigned i = 0; i < buckets.Size(); ++i)
+    {
+        if(buckets[i].Empty())
+            continue;
+
+        JSONValue point = GetTimingSummary(buckets[i]);
+        point.Set("drones", i * droneBucket_);
+        curve.Push(point);
+
+        //the frame time breaks down at the first drone count where the slow frames go over the budget
+        if(breakdownDrones < 0 && point.Get("p95").GetFloat() > frameBudget_)
+            breakdownDrones = i * droneBucket_;
+    }
+
+    JSONValue scaling;
+    scaling.Set("droneBucket", droneBucket_);
+    scaling.Set("frameBudgetMs", frameBudget_);
+    scaling.Set("breakdownDrones", breakdownDrones);
+    scaling.Set("frameTimeMs", curve);
+
+    return scaling;
+}
+
+void BenchmarkRunner::WriteReport()
+{
+    JSONValue entities;
+    auto* entityIndex = scene_ ? scene_->GetComponent<EntityIndex>() : nullptr;
+    entities.Set("drones", entityIndex ? entityIndex->GetTaggedCount("drone") : 0);
+    entities.Set("peakDrones", peakDrones_);
+    entities.Set("scriptedNodes", entityIndex ? entityIndex->GetScriptedCount() : 0);
+    entities.Set("sceneNodes", scene_ ? scene_->GetNumChildren(true) : 0);
+    entities.Set("peakSceneNodes", peakSceneNodes_);
+    entities.Set("dronesDestroyed", dronesDestroyed_);
+
+    JSONFile report(context_);
+    JSONValue& root = report.GetRoot();
+    root.Set("scenario", scenarioName_);
+    root.Set("seed", seed_);
+    root.Set("timeStep", timeStep_);
+    root.Set("simulatedTime", elapsedTime_);
+    root.Set("frameTimeMs", GetTimingSummary(frameTimes_));
+    root.Set("fixedStepMs", GetTimingSummary(stepTimes_));
+    root.Set("entities", entities);
+    root.Set("scaling", GetScalingSummary());
+
+    auto* fileSystem = GetSubsystem<FileSystem>();
+    String dirName = fileSystem->GetCurrentDir() + "AppLog";
+    if(!fileSystem->DirExists(dirName))
+    {
+        fileSystem->CreateDir(dirName);
+    }
+
+    String fileName = dirName + "/Benchmark_" + scenarioName_ + ".json";
+    if(report.SaveFile(fileName))
+    {
+        URHO3D_LOGINFO("Benchmark report written to " + fileName);
+    }
+
+    PrintLine(report.ToString("  "));
+}
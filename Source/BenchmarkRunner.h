@@ -0,0 +1,115 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef BENCHMARKRUNNER_H
+#define BENCHMARKRUNNER_H
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Core/Object.h>
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/Resource/JSONValue.h>
+
+#include "EventsAndDefs.h"
+
+namespace Urho3D
+{
+    class Scene;
+}
+
+class LevelManager;
+
+using namespace Urho3D;
+
+/// Runs a benchmark scenario on the level at a fixed timestep with synthetic input, then writes a JSON report
+/// with frame time percentiles, fixed step cost and entity counts and exits the engine.
+class BenchmarkRunner : public Object
+{
+    URHO3D_OBJECT(BenchmarkRunner, Object)
+
+public:
+    BenchmarkRunner(Context* context);
+
+    /// Load a scenario by name from Benchmarks/ or by resource path. Return true if successful.
+    bool LoadScenario(const String& scenario);
+    /// Watch the level scene. Must be called before the level populates the scene, so that the fixed step
+    /// timing runs before the level's own physics step handlers.
+    void SetScene(Scene* scene);
+    /// Start the level with the scenario settings and run until the scenario duration has been simulated.
+    void Run(LevelManager* levelManager);
+
+    /// Return scenario random seed.
+    unsigned GetSeed() const { return seed_; }
+
+    /// Return summary statistics of timing samples in milliseconds.
+    static JSONValue GetTimingSummary(const PODVector<float>& samples);
+
+private:
+    void HandleBeginFrame(StringHash eventType, VariantMap& eventData);
+    void HandleEndFrame(StringHash eventType, VariantMap& eventData);
+    void HandleUpdate(StringHash eventType, VariantMap& eventData);
+    void HandlePhysicsPreStep(StringHash eventType, VariantMap& eventData);
+    void HandlePhysicsPostStep(StringHash eventType, VariantMap& eventData);
+    void HandleDronesDestroyed(const DroneDestroyed::Data* events, unsigned count);
+
+    /// Track current and peak entity counts.
+    void SampleEntities();
+    /// Return the frame time summaries by live drone count and the drone count at which the frame budget is exceeded.
+    JSONValue GetScalingSummary() const;
+    /// Write the report to the log directory and standard output.
+    void WriteReport();
+
+    String scenarioName_;
+    unsigned seed_;
+    float duration_;
+    float timeStep_;
+    /// Level settings handed to the level script.
+    VariantMap levelSettings_;
+    /// Synthetic mouse movement per frame.
+    int yawInput_;
+    int pitchInput_;
+    float fireInterval_;
+
+    WeakPtr<Scene> scene_;
+    WeakPtr<LevelManager> levelManager_;
+
+    HiresTimer frameTimer_;
+    HiresTimer stepTimer_;
+    /// Frame times in milliseconds.
+    PODVector<float> frameTimes_;
+    /// Fixed step times in milliseconds.
+    PODVector<float> stepTimes_;
+    /// Live drones at the end of each frame.
+    PODVector<unsigned> frameDrones_;
+    /// Drone count range the frame times are grouped by.
+    unsigned droneBucket_;
+    /// Frame time budget in milliseconds.
+    float frameBudget_;
+    float elapsedTime_;
+    float fireTimer_;
+    unsigned currentDrones_;
+    unsigned peakDrones_;
+    unsigned peakSceneNodes_;
+    unsigned dronesDestroyed_;
+    bool running_;
+};
+
+#endif // BENCHMARKRUNNER_H
@@ -28,6 +28,8 @@
 #include <Urho3D/Resource/ResourceCache.h>
 #include <Urho3D/Engine/Engine.h>
 #include <Urho3D/Engine/EngineDefs.h>
+#include <Urho3D/Core/ProcessUtils.h>
+#include <Urho3D/Core/WorkQueue.h>
 #include <Urho3D/Engine/DebugHud.h>
 #include <Urho3D/Engine/Application.h>
 
@@ -65,6 +67,29 @@
 #include <Urho3D/Audio/Sound.h>
 
 #include "LevelManager.h"
+#include "BenchmarkRunner.h"
+#include "PerfCounters.h"
+#include "DroneSwarmSystem.h"
+#include "EntityIndex.h"
+#include "GameEventChannel.h"
+#include "GameRandom.h"
+#include "InputRecorder.h"
+#include "NodePool.h"
+#include "ParallelUpdate.h"
+#include "PlayerInput.h"
+#include "PlayerLook.h"
+#include "PrefabCache.h"
+#include "ProjectileSystem.h"
+#include "RadarDisplay.h"
+#include "ResourceBudget.h"
+#include "ResourcePreloader.h"
+#include "ScriptLoader.h"
+#include "SimulationClock.h"
+#include "SoundVoiceManager.h"
+#include "TextureRouter.h"
+#include "WaveScheduler.h"
+#include "ScriptAPI.h"
+#include "ScriptGC.h"
 #include "EventsAndDefs.h"
 #include "DroneAnarchy.h"
 
@@ -73,18 +98,51 @@
 
 #include <emscripten/emscripten.h>
 #include <emscripten/bind.h>
+#ifdef __EMSCRIPTEN_PTHREADS__
+#include <emscripten/threading.h>
+#endif
 
 static DroneAnarchy *webInstance;
 
+/// Package with the game data that the intro does not use, downloaded while the intro plays (see CMakeLists.txt).
+static const char* LEVEL_BUNDLE = "Level.pak";
+
 #endif
 
 DroneAnarchy::DroneAnarchy(Urho3D::Context *context) : Application(context), useMouseMode_(MM_ABSOLUTE)
 , showingIntroScene_(true)
 , hasPointerLock_(false)
+, randomSeed_(0)
+, compileScripts_(false)
+, workerThreads_(-1)
+, physicsFps_(0)
+, levelStartPending_(false)
 {
 
     context_->RegisterSubsystem(new Script(context_));
+    context_->RegisterSubsystem(new ScriptGC(context_));
+    context_->RegisterSubsystem(new PrefabCache(context_));
+    context_->RegisterSubsystem(new PerfCounters(context_));
+    context_->RegisterSubsystem(new GameEventChannel(context_));
+    context_->RegisterSubsystem(new GameRandom(context_));
+    context_->RegisterSubsystem(new PlayerInput(context_));
+    context_->RegisterSubsystem(new InputRecorder(context_));
+    context_->RegisterSubsystem(new ScriptLoader(context_));
+    context_->RegisterSubsystem(new ResourcePreloader(context_));
+    context_->RegisterSubsystem(new ResourceBudget(context_));
+    context_->RegisterSubsystem(new ParallelUpdate(context_));
     context_->RegisterFactory<LevelManager>();
+    DroneSwarmSystem::RegisterObject(context_);
+    NodePool::RegisterObject(context_);
+    ProjectileSystem::RegisterObject(context_);
+    EntityIndex::RegisterObject(context_);
+    RadarDisplay::RegisterObject(context_);
+    SimulationClock::RegisterObject(context_);
+    PlayerLook::RegisterObject(context_);
+    SoundVoiceManager::RegisterObject(context_);
+    WaveScheduler::RegisterObject(context_);
+
+    RegisterGameScriptAPI(context_);
 
 #ifdef __EMSCRIPTEN__
     webInstance = this;
@@ -94,10 +152,90 @@ DroneAnarchy::DroneAnarchy(Urho3D::Context *context) : Application(context), use
 
 void DroneAnarchy::Setup()
 {
-    //seed the random number function
-    srand(time(NULL) % 1000);
+    //--benchmark <scenario> runs the level headless and exits with a report
+    const Vector<String>& arguments = GetArguments();
+    for(unsigned i = 0; i < arguments.Size(); ++i)
+    {
+        if(arguments[i] == "--compile-scripts")
+        {
+            //writes the script bytecode next to the sources and exits, used by the CompileScripts target
+            compileScripts_ = true;
+        }
+        else if(i + 1 >= arguments.Size())
+        {
+            break;
+        }
+        else if(arguments[i] == "--benchmark")
+        {
+            benchmarkScenario_ = arguments[i + 1];
+        }
+        else if(arguments[i] == "--record")
+        {
+            //records the input of the session from entering the level on, for replaying it later
+            recordFile_ = arguments[i + 1];
+        }
+        else if(arguments[i] == "--replay")
+        {
+            //replays a recorded session instead of playing, rendered or with -headless
+            replayFile_ = arguments[i + 1];
+        }
+        else if(arguments[i] == "--asset-url")
+        {
+            //where the web build downloads its level bundle from, the directory of the page when not given
+            assetUrl_ = arguments[i + 1];
+        }
+        else if(arguments[i] == "--worker-threads")
+        {
+            //number of worker threads for the engine and the parallel gameplay update, 0 runs everything on the main thread
+            workerThreads_ = ToInt(arguments[i + 1]);
+        }
+        else if(arguments[i] == "--physics-fps")
+        {
+            //physics steps per second, natively simulated nodes are drawn between the steps
+            physicsFps_ = ToInt(arguments[i + 1]);
+        }
+        else if(arguments[i] == "--gc-budget")
+        {
+            //milliseconds of script garbage collection per gameplay frame
+            GetSubsystem<ScriptGC>()->SetFrameBudget(ToFloat(arguments[i + 1]));
+        }
+        else if(arguments[i] == "--perf-csv")
+        {
+            //seconds between writes of the timing counters to AppLog/PerfCounters.csv
+            GetSubsystem<PerfCounters>()->SetCsvInterval(ToFloat(arguments[i + 1]));
+        }
+    }
 
-    engineParameters_[EP_RESOURCE_PATHS] = "CoreData;GameData;GameLogic";
+    //seed of the random number generator, benchmarks and replays are seeded from their files instead
+    randomSeed_ = (unsigned)time(NULL);
+
+    FileSystem* filesystem = GetSubsystem<FileSystem>();
+
+    //packaged resources (see the PackageResources target) are added next to the loose directories, which are
+    //searched first so that edited files override the packages during development
+    const char* resourceNames[] = { "CoreData", "GameData", "GameLogic" };
+    String programDir = filesystem->GetProgramDir();
+    Vector<String> resourcePaths;
+    Vector<String> resourcePackages;
+
+    for(const char* name : resourceNames)
+    {
+        bool hasDir = filesystem->DirExists(programDir + name);
+        bool hasPackage = filesystem->FileExists(programDir + name + ".pak");
+
+        if(hasPackage)
+            resourcePackages.Push(String(name) + ".pak");
+
+        //an absolute directory is added as is, a relative name also picks up <name>.pak from the prefix paths, which
+        //would add the package twice. The engine searches its prefix paths for anything not found next to the executable
+        if(hasDir)
+            resourcePaths.Push(programDir + name);
+        else if(!hasPackage)
+            resourcePaths.Push(name);
+    }
+
+    engineParameters_[EP_RESOURCE_PATHS] = String::Joined(resourcePaths, ";");
+    engineParameters_[EP_RESOURCE_PACKAGES] = String::Joined(resourcePackages, ";");
 
 #ifdef __EMSCRIPTEN__
     engineParameters_[EP_FULL_SCREEN] = false;
@@ -106,7 +244,6 @@ void DroneAnarchy::Setup()
     engineParameters_[EP_FULL_SCREEN] = true;
 #endif
 
-    FileSystem* filesystem = GetSubsystem<FileSystem>();
     String dirName = filesystem->GetCurrentDir() + "AppLog";
 
     if(!filesystem->DirExists(dirName))
@@ -115,6 +252,28 @@ void DroneAnarchy::Setup()
     }
 
     engineParameters_["LogName"] = dirName + "/DroneAnarchy.log";
+
+#ifdef __EMSCRIPTEN_PTHREADS__
+    //the multithreaded web build takes its work queue threads from the pthread pool, a thread beyond the pool
+    //would only start after the main thread yields to the browser
+    if(workerThreads_ < 0)
+    {
+        workerThreads_ = Min(DRONEANARCHY_WEB_WORKER_THREADS, Max(emscripten_num_logical_cores() - 1, 1));
+    }
+#endif
+
+    //the engine creates one worker thread per core unless the count is given, the threads are then created in Start
+    if(workerThreads_ >= 0)
+    {
+        engineParameters_[EP_WORKER_THREADS] = false;
+    }
+
+    if(!benchmarkScenario_.Empty() || compileScripts_)
+    {
+        engineParameters_[EP_HEADLESS] = true;
+        engineParameters_[EP_FULL_SCREEN] = false;
+        engineParameters_[EP_SOUND] = false;
+    }
 }
 
 void DroneAnarchy::Start()
@@ -124,11 +283,71 @@ void DroneAnarchy::Start()
     hasPointerLock_ = true;
 #endif
 
+    if(workerThreads_ > 0)
+    {
+        GetSubsystem<WorkQueue>()->CreateThreads(workerThreads_);
+    }
+
+    //loose resource files override the entries of the resource packages
     auto* cache = GetSubsystem<ResourceCache>();
-    cache->BackgroundLoadResource<Sound>("Sounds/through_space_(modified).ogg");
-    cache->BackgroundLoadResource<Sound>("Sounds/cyber_dance.ogg");
+    cache->SetSearchPackagesFirst(false);
+    //texture images are read from their compressed versions when there are any
+    cache->AddResourceRouter(new TextureRouter(context_));
 
-    SetRandomSeed(rand());
+    if(compileScripts_)
+    {
+        if(!GetSubsystem<ScriptLoader>()->CompileScripts())
+            ErrorExit("Could not compile the scripts to bytecode");
+        else
+            engine_->Exit();
+        return;
+    }
+
+    //unused resources are released when their group goes over its budget
+    if(!GetSubsystem<ResourceBudget>()->LoadBudgets("Settings/MemoryBudgets.xml"))
+    {
+        URHO3D_LOGWARNING("Could not load the resource memory budgets");
+    }
+
+    if(!benchmarkScenario_.Empty())
+    {
+        StartBenchmark();
+        return;
+    }
+
+    if(!replayFile_.Empty())
+    {
+        StartReplay();
+        return;
+    }
+
+#ifdef _DEBUG
+    //pick up edited scripts and prefab object files while the game runs
+    cache->SetAutoReloadResources(true);
+#endif
+
+    //the intro waits only on the files it uses while the rest of its manifest and the level stream in behind it
+    auto* preloader = GetSubsystem<ResourcePreloader>();
+    preloader->LoadManifest("Manifests/Intro.xml");
+
+#ifdef __EMSCRIPTEN__
+    //the page preloads only the boot bundle, the level is created in the intro once its bundle has arrived
+    if(!preloader->DownloadPackage(assetUrl_ + LEVEL_BUNDLE, LEVEL_BUNDLE))
+    {
+        ErrorExit("Could not download the level bundle");
+        return;
+    }
+#else
+    preloader->LoadManifest("Manifests/Level.xml");
+#endif
+
+    SetRandomSeed(randomSeed_);
+    GetSubsystem<GameRandom>()->SetSeed(randomSeed_);
+
+    if(!recordFile_.Empty() && !GetSubsystem<InputRecorder>()->StartRecording(recordFile_, randomSeed_))
+    {
+        URHO3D_LOGERROR("Could not record input to " + recordFile_);
+    }
 
     SetupAudioGain();
     
@@ -136,9 +355,13 @@ void DroneAnarchy::Start()
 
     CreateDebugHud();
 
+    CreateIntroUI();
+
     CreateIntroScene();
 
+#ifndef __EMSCRIPTEN__
     CreateLevel();
+#endif
 
     SubscribeToEvents();
 
@@ -149,6 +372,7 @@ void DroneAnarchy::Start()
 
 void DroneAnarchy::Stop()
 {
+    GetSubsystem<InputRecorder>()->Stop();
 }
 
 void DroneAnarchy::SetupAudioGain()
@@ -175,14 +399,26 @@ void DroneAnarchy::HandleKeyDown(Urho3D::StringHash eventType, Urho3D::VariantMa
     {
         GetSubsystem<DebugHud>()->ToggleAll();
     }
+    else if(key == KEY_F3)
+    {
+        GetSubsystem<PerfCounters>()->ToggleOverlay();
+    }
+    else if(key == KEY_F4)
+    {
+        URHO3D_LOGINFO(GetSubsystem<ResourceBudget>()->GetReport(20));
+    }
+    else if(key == KEY_F5)
+    {
+        URHO3D_LOGINFO(GetSubsystem<ScriptGC>()->GetReport());
+    }
     else if( showingIntroScene_ && KEY_ESCAPE)
     {
         engine_->Exit();
     }
-    else
+    else if( !IsReplaying() && levelManager_ )
     {
-        eventData["ID"] = EVT_KEYDOWN;
-        levelManager_->HandleLevelEvent(eventData);
+        GetSubsystem<InputRecorder>()->RecordLevelEvent(EVT_KEYDOWN, eventData);
+        levelManager_->HandleLevelEvent(EVT_KEYDOWN, eventData);
     }
 }
 
@@ -194,8 +430,19 @@ void DroneAnarchy::HandleMouseMove(StringHash eventType, VariantMap &eventData)
         return;
     }
 
-    eventData["ID"] = EVT_MOUSEMOVE;
-    levelManager_->HandleLevelEvent(eventData);
+    using namespace MouseMove;
+
+    if( IsReplaying() )
+    {
+        return;
+    }
+
+    int dx = eventData[P_DX].GetInt();
+    int dy = eventData[P_DY].GetInt();
+
+    //a fast mouse sends many moves per frame, they are summed up and applied once by the player look
+    GetSubsystem<PlayerInput>()->AddLookDelta(dx, dy);
+    GetSubsystem<InputRecorder>()->RecordLook(dx, dy);
 }
 
 void DroneAnarchy::HandleMouseClick(StringHash eventType, VariantMap &eventData)
@@ -211,19 +458,29 @@ void DroneAnarchy::HandleMouseClick(StringHash eventType, VariantMap &eventData)
 
     if( showingIntroScene_ )
     {
-        showingIntroScene_ = false;
-        introScene_->GetComponent<SoundSource>()->Stop();
-        introScene_->SetUpdateEnabled( false );
-        introUI_->SetVisible(false);
-        levelManager_->StartOrResumeLevel();
+        StartLevelWhenLoaded();
         return;
     }
 
 #endif
+
+    if( IsReplaying() )
+    {
+        return;
+    }
+
+    //the level polls the press in its update
+    if(eventData[MouseButtonDown::P_BUTTON].GetInt() == MOUSEB_LEFT)
+    {
+        GetSubsystem<PlayerInput>()->PressFire();
+        GetSubsystem<InputRecorder>()->RecordFire();
+    }
 }
 
 void DroneAnarchy::HandleUpdate(StringHash eventType, VariantMap &eventData)
 {
+    PerfScope scope(GetSubsystem<PerfCounters>(), "DroneAnarchy::HandleUpdate");
+
     //if intro scene is shoing then handle update for intro scene scenarios
     if(showingIntroScene_){
         HandleIntroSceneUpdate( eventData );
@@ -247,8 +504,7 @@ void DroneAnarchy::HandleUpdate(StringHash eventType, VariantMap &eventData)
     }
     else
     {
-        eventData["ID"] = EVT_UPDATE;
-        levelManager_->HandleLevelEvent(eventData);
+        levelManager_->HandleLevelEvent(EVT_UPDATE, eventData);
     }
 }
 
@@ -258,66 +514,197 @@ void DroneAnarchy::HandleIntroSceneUpdate(VariantMap &eventData)
 
     float timeStep = eventData[P_TIMESTEP].GetFloat();
     introDroneNode_->Yaw(timeStep * 200);
+
+    auto* preloader = GetSubsystem<ResourcePreloader>();
+
+#ifdef __EMSCRIPTEN__
+    if(!levelManager_ && preloader->HasPackage(LEVEL_BUNDLE))
+    {
+        preloader->LoadManifest("Manifests/Level.xml");
+        CreateLevel();
+    }
+#endif
+
+    loadingText_->SetVisible(levelStartPending_);
+
+    if(!levelStartPending_)
+        return;
+
+    if(preloader->HasDownloadFailed())
+        loadingText_->SetText("COULD NOT DOWNLOAD THE LEVEL");
+    else if(preloader->IsDownloading())
+        loadingText_->SetText("DOWNLOADING " + String((int)(preloader->GetDownloadProgress() * 100.0f)) + "%");
+    else if(levelManager_ && preloader->IsComplete())
+        StartLevelWhenLoaded();
+    else
+        loadingText_->SetText("LOADING " + String((int)(preloader->GetProgress() * 100.0f)) + "%");
 }
 
 void DroneAnarchy::HandleSoundFinished(StringHash eventType, VariantMap &eventData)
 {
-    eventData["ID"] = EVT_SOUNDFINISH;
-    levelManager_->HandleLevelEvent(eventData);
+    if( !levelManager_ )
+    {
+        return;
+    }
+
+    levelManager_->HandleLevelEvent(EVT_SOUNDFINISH, eventData);
 }
 
 void DroneAnarchy::HandleJoystickButtonDown(StringHash eventType, VariantMap &eventData)
 {
-    //no event handling if no pointer lock
-    if( !hasPointerLock_ )
+    //no event handling if no pointer lock or no level yet
+    if( !hasPointerLock_ || IsReplaying() || !levelManager_ )
     {
         return;
     }
     
-    eventData["ID"] = EVT_JOYSTICK_BUTTONDOWN;
-    levelManager_->HandleLevelEvent(eventData);
+    GetSubsystem<InputRecorder>()->RecordLevelEvent(EVT_JOYSTICK_BUTTONDOWN, eventData);
+    levelManager_->HandleLevelEvent(EVT_JOYSTICK_BUTTONDOWN, eventData);
 }
 
 void DroneAnarchy::HandleJoystickButtonUp(StringHash eventType, VariantMap &eventData)
 {
-    //no event handling if no pointer lock
-    if( !hasPointerLock_ )
+    //no event handling if no pointer lock or no level yet
+    if( !hasPointerLock_ || IsReplaying() || !levelManager_ )
     {
         return;
     }
     
-    eventData["ID"] = EVT_JOYSTICK_BUTTONUP;
-    levelManager_->HandleLevelEvent(eventData);
+    GetSubsystem<InputRecorder>()->RecordLevelEvent(EVT_JOYSTICK_BUTTONUP, eventData);
+    levelManager_->HandleLevelEvent(EVT_JOYSTICK_BUTTONUP, eventData);
 }
 
 void DroneAnarchy::HandleHatMove(StringHash eventType, VariantMap &eventData)
 {
-    //no event handling if no pointer lock
-    if( !hasPointerLock_ )
+    //no event handling if no pointer lock or no level yet
+    if( !hasPointerLock_ || IsReplaying() || !levelManager_ )
     {
         return;
     }
     
-    eventData["ID"] = EVT_JOYSTICK_HATMOVE;
-    levelManager_->HandleLevelEvent(eventData);
+    GetSubsystem<InputRecorder>()->RecordLevelEvent(EVT_JOYSTICK_HATMOVE, eventData);
+    levelManager_->HandleLevelEvent(EVT_JOYSTICK_HATMOVE, eventData);
+}
+
+void DroneAnarchy::HandleCountFinished(StringHash eventType, VariantMap &eventData)
+{
+    //the countdown is part of a recording, replays end it where it ended when recorded
+    GetSubsystem<InputRecorder>()->RecordTransition(RT_COUNTFINISHED);
+
+    if( !IsReplaying() )
+    {
+        GetSubsystem<GameEventChannel>()->Post(CountFinished::Data());
+    }
 }
 
 void DroneAnarchy::CreateLevel()
 {
     ResourceCache* cache = GetSubsystem<ResourceCache>();
+
+    //the game objects are first needed when the level starts, so they can finish loading while the intro shows
+    auto* scriptLoader = GetSubsystem<ScriptLoader>();
+    scriptLoader->Preload("Scripts/GameObjects.as", !benchmark_ && !IsReplaying());
+    scriptLoader->Preload("Scripts/LevelManager.as", false);
+
     XMLFile* file = cache->GetResource<XMLFile>("Objects/Scene.xml");
 
     levelScene_ = new Scene(context_);
     levelScene_->LoadXML(file->GetRoot());
 
+    //nothing advances the level's physics clock before the level is entered, so that the steps of a session only
+    //depend on its frame timesteps
+    levelScene_->SetUpdateEnabled(false);
+
+    auto* clock = levelScene_->CreateComponent<SimulationClock>(LOCAL);
+    clock->SetStepsPerSecond(physicsFps_);
+
+    if(benchmark_)
+    {
+        benchmark_->SetScene(levelScene_);
+    }
+
     levelManager_ = levelScene_->CreateComponent<LevelManager>();
     levelManager_->InitialiseAndActivate();
 }
 
-void DroneAnarchy::CreateIntroScene()
+void DroneAnarchy::StartLevelWhenLoaded()
 {
-    CreateIntroUI();
+    //only gated when the level bundle or something the level uses is still loading
+    if(!levelManager_ || !GetSubsystem<ResourcePreloader>()->IsComplete())
+    {
+        levelStartPending_ = true;
+        return;
+    }
+
+    levelStartPending_ = false;
+    showingIntroScene_ = false;
+    introUI_->SetVisible(false);
+    GetSubsystem<InputRecorder>()->RecordTransition(RT_STARTLEVEL);
+    levelManager_->StartOrResumeLevel();
+
+    //the level has taken over the viewport, the intro scene is created again when it is shown again, and the
+    //preloaded resources that neither the level nor the intro use are left to the memory budgets
+    GetSubsystem<ResourcePreloader>()->ReleaseResources();
+    introScene_.Reset();
+    introViewport_.Reset();
+    introCamera_.Reset();
+    introDroneNode_.Reset();
+}
 
+void DroneAnarchy::StartBenchmark()
+{
+    benchmark_ = new BenchmarkRunner(context_);
+    if(!benchmark_->LoadScenario(benchmarkScenario_))
+    {
+        ErrorExit("Could not load benchmark scenario " + benchmarkScenario_);
+        return;
+    }
+
+    srand(benchmark_->GetSeed());
+    GetSubsystem<GameRandom>()->SetSeed(benchmark_->GetSeed());
+
+    //there is no intro, pointer or window in headless mode, the level takes the updates right away
+    hasPointerLock_ = true;
+    showingIntroScene_ = false;
+
+    GetSubsystem<ResourcePreloader>()->LoadManifest("Manifests/Level.xml");
+
+    CreateLevel();
+    SubscribeToEvents();
+
+    benchmark_->Run(levelManager_);
+}
+
+void DroneAnarchy::StartReplay()
+{
+    auto* recorder = GetSubsystem<InputRecorder>();
+    if(!recorder->LoadReplay(replayFile_))
+    {
+        ErrorExit("Could not load input recording " + replayFile_);
+        return;
+    }
+
+    //the recording starts where the level is entered, there is no intro and the live input is ignored
+    hasPointerLock_ = true;
+    showingIntroScene_ = false;
+
+    if(GetSubsystem<Graphics>())
+    {
+        SetupAudioGain();
+        SetWindowTitleAndIcon();
+        CreateDebugHud();
+    }
+
+    GetSubsystem<ResourcePreloader>()->LoadManifest("Manifests/Level.xml");
+
+    CreateLevel();
+    SubscribeToEvents();
+
+    recorder->Replay(levelManager_);
+}
+
+void DroneAnarchy::CreateIntroScene()
+{
     auto *cache = GetSubsystem<ResourceCache>();
 
     introScene_ = new Scene(context_);
@@ -422,6 +809,15 @@ void DroneAnarchy::CreateIntroUI()
     instructionText->SetTextEffect(TextEffect::TE_SHADOW);
     instructionText->SetColor( Color(0.239, 0.913, 1) );
     instructionText->SetPosition( 0, 150);
+
+    loadingText_ = introUI_->CreateChild<Text>();
+    loadingText_->SetAlignment( HA_CENTER, VA_BOTTOM );
+    loadingText_->SetFont( cache->GetResource<Font>("Fonts/Anonymous Pro.ttf"));
+    loadingText_->SetFontSize(20);
+    loadingText_->SetTextEffect(TextEffect::TE_SHADOW);
+    loadingText_->SetColor( Color(0.239, 0.913, 1) );
+    loadingText_->SetPosition( 0, -40);
+    loadingText_->SetVisible(false);
 }
 
 void DroneAnarchy::CreateDebugHud()
@@ -452,6 +848,7 @@ void DroneAnarchy::SubscribeToEvents()
     SubscribeToEvent(E_MOUSEBUTTONDOWN, URHO3D_HANDLER(DroneAnarchy, HandleMouseClick));
     SubscribeToEvent(E_UPDATE, URHO3D_HANDLER(DroneAnarchy, HandleUpdate));
     SubscribeToEvent(E_SOUNDFINISHED, URHO3D_HANDLER(DroneAnarchy, HandleSoundFinished));
+    SubscribeToEvent(E_COUNTFINISHED, URHO3D_HANDLER(DroneAnarchy, HandleCountFinished));
 
     Input* input = GetSubsystem<Input>();
     if(input->GetNumJoysticks() >  0)
@@ -531,10 +928,9 @@ void DroneAnarchy::HandleWebResized()
 
 
     VariantMap eventData;
-    eventData["ID"] = EVT_WEB_WINDOW_RESIZED;
     eventData["CurrentWebWindowSize"] = rect;
     
-    levelManager_->HandleLevelEvent(eventData);
+    levelManager_->HandleLevelEvent(EVT_WEB_WINDOW_RESIZED, eventData);
 }
 
 void DroneAnarchy::PonterLockAcquired()
@@ -545,11 +941,7 @@ void DroneAnarchy::PonterLockAcquired()
     }
 
     hasPointerLock_ = true;
-    showingIntroScene_ = false;
-    introScene_->GetComponent<SoundSource>()->Stop();
-    introScene_->SetUpdateEnabled( false );
-    introUI_->SetVisible(false);
-    levelManager_->StartOrResumeLevel();
+    StartLevelWhenLoaded();
 }
 
 void DroneAnarchy::PointerLockLost()
@@ -560,19 +952,19 @@ void DroneAnarchy::PointerLockLost()
     }
     
     hasPointerLock_ = false;
-    showingIntroScene_ = true;
+    levelStartPending_ = false;
 
-    auto *cache = GetSubsystem<ResourceCache>();
+    //the pointer was lost while waiting on the intro, the level was never entered
+    if(showingIntroScene_)
+    {
+        return;
+    }
 
-    auto* music = cache->GetResource<Sound>("Sounds/through_space_(modified).ogg");
-    // Set the song to loop
-    music->SetLooped(true);
+    showingIntroScene_ = true;
 
-    introScene_->GetComponent<SoundSource>()->Play(music);
-    introScene_->SetUpdateEnabled( true );
+    CreateIntroScene();
     introUI_->SetVisible(true);
-    auto* renderer = GetSubsystem<Renderer>();
-    renderer->SetViewport(0, introViewport_);
+    GetSubsystem<InputRecorder>()->RecordTransition(RT_DEACTIVATE);
     levelManager_->Deactivate();
 }
 
@@ -45,6 +45,7 @@ public:
     void HandleJoystickButtonDown(StringHash eventType, VariantMap& eventData);
     void HandleJoystickButtonUp(StringHash eventType, VariantMap& eventData);
     void HandleHatMove(StringHash eventType, VariantMap& eventData);
+    void HandleCountFinished(StringHash eventType, VariantMap& eventData);
 
     /// Handle request for mouse mode on web platform.
     void HandleMouseModeRequest(StringHash eventType, VariantMap& eventData);
@@ -63,11 +64,19 @@ private:
     void SubscribeToEvents();
     void SetWindowTitleAndIcon();
     void CreateLevel();
+    /// Leave the intro and start or resume the level, or wait on the intro until the level resources are loaded.
+    void StartLevelWhenLoaded();
+    /// Run the benchmark scenario given on the command line instead of the game.
+    void StartBenchmark();
+    /// Replay the input recording given on the command line instead of the game.
+    void StartReplay();
     void CreateIntroScene();
     void CreateIntroUI();
     void CreateDebugHud();
     void SetupAudioGain();
     void UpdateIntroUIDimension();
+    /// Return whether a recording is replayed, in which case the live input is ignored.
+    bool IsReplaying() const { return !replayFile_.Empty(); }
 
     bool hasPointerLock_;
 
@@ -77,12 +86,32 @@ private:
     SharedPtr<Camera> introCamera_;
     SharedPtr<Node> introDroneNode_;
     SharedPtr<UIElement> introUI_;
+    SharedPtr<Text> loadingText_;
 
     WeakPtr<LevelManager> levelManager_;
 
+    /// Benchmark scenario from the --benchmark option, empty when playing normally.
+    String benchmarkScenario_;
+    SharedPtr<BenchmarkRunner> benchmark_;
+    /// Input recording to write from the --record option, or to replay from the --replay option.
+    String recordFile_;
+    String replayFile_;
+    /// Base URL of the web build's level bundle from the --asset-url option, empty for the directory of the page.
+    String assetUrl_;
+    /// Seed of the random number generator when playing normally.
+    unsigned randomSeed_;
+    /// Compile the scripts to bytecode and exit, set by the --compile-scripts option.
+    bool compileScripts_;
+    /// Number of worker threads from the --worker-threads option, negative for the engine default.
+    int workerThreads_;
+    /// Physics steps per second from the --physics-fps option, 0 for the scene's own setting.
+    int physicsFps_;
+
     /// Mouse mode option to use in the sample.
     MouseMode useMouseMode_;
     bool showingIntroScene_;
+    /// The player asked to enter the level before its resources finished loading.
+    bool levelStartPending_;
 };
 
 #endif // #ifndef __DRONEANARCHY_H_
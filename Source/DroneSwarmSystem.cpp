@@ -0,0 +1,509 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Scene/Scene.h>
+#include <Urho3D/Scene/SceneEvents.h>
+#include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/Physics/PhysicsWorld.h>
+#include <Urho3D/Physics/PhysicsEvents.h>
+#include <Urho3D/Physics/RigidBody.h>
+#include <Urho3D/Graphics/AnimatedModel.h>
+#include <Urho3D/Graphics/AnimationController.h>
+#include <Urho3D/AngelScript/Script.h>
+#include <Urho3D/AngelScript/ScriptFile.h>
+#include <Urho3D/AngelScript/ScriptInstance.h>
+
+#include "EventsAndDefs.h"
+#include "GameEventChannel.h"
+#include "GameRandom.h"
+#include "NodePool.h"
+#include "ParallelUpdate.h"
+#include "PerfCounters.h"
+#include "PrefabCache.h"
+#include "SimulationClock.h"
+#include "DroneSwarmSystem.h"
+
+//Fewest drones worth a batch of their own on a worker thread
+static const unsigned MIN_PARALLEL_DRONES = 64;
+
+DroneSwarmSystem::DroneSwarmSystem(Context *context) : Component(context)
+, droneHealth_(6.0f)
+, dronePoint_(2)
+, damagePoint_(2.0f)
+, approachTime_(20.0f)
+, attackDistance_(50.0f)
+, spawnOffset_(0.0f, 4.0f, 40.0f)
+, approachTarget_(0.0f, 4.0f, -35.0f)
+, attackVelocity_(0.0f, -25.0f, -35.0f)
+, droneObjectFile_("Objects/SwarmDrone.xml")
+, reducedAnimationDistance_(15.0f)
+, frozenAnimationDistance_(30.0f)
+, reducedAnimationLodBias_(0.25f)
+, pathStep_(0.0f)
+, playerHitMethod_("void OnHit(float)")
+{
+
+}
+
+void DroneSwarmSystem::RegisterObject(Context *context)
+{
+    context->RegisterFactory<DroneSwarmSystem>();
+
+    URHO3D_ATTRIBUTE("Drone Health", droneHealth_, 6.0f, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Drone Point", dronePoint_, 2, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Damage Point", damagePoint_, 2.0f, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Approach Time", approachTime_, 20.0f, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Attack Distance Squared", attackDistance_, 50.0f, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Spawn Offset", spawnOffset_, Vector3(0.0f, 4.0f, 40.0f), AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Approach Target", approachTarget_, Vector3(0.0f, 4.0f, -35.0f), AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Attack Velocity", attackVelocity_, Vector3(0.0f, -25.0f, -35.0f), AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Drone Object File", droneObjectFile_, String("Objects/SwarmDrone.xml"), AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Reduced Animation Distance", reducedAnimationDistance_, 15.0f, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Frozen Animation Distance", frozenAnimationDistance_, 30.0f, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Reduced Animation LOD Bias", reducedAnimationLodBias_, 0.25f, AM_DEFAULT);
+}
+
+Node* DroneSwarmSystem::SpawnDrone()
+{
+    return SpawnDrone(GetSubsystem<GameRandom>()->Random(360.0f));
+}
+
+Node* DroneSwarmSystem::SpawnDrone(float bearing)
+{
+    Scene* scene = GetScene();
+    if(!scene)
+        return nullptr;
+
+    Quaternion rot(0.0f, bearing, 0.0f);
+
+    Node* droneNode = GetSubsystem<PrefabCache>()->SpawnPrefab(scene, droneObjectFile_, rot * spawnOffset_, rot);
+    if(!droneNode)
+        return nullptr;
+
+    auto* animController = droneNode->GetComponent<AnimationController>();
+    if(animController)
+    {
+        animController->PlayExclusive("Models/open_arm.ani", 0, false);
+    }
+
+    indices_[droneNode->GetID()] = nodes_.Size();
+
+    startPositions_.Push(droneNode->GetPosition());
+    endPositions_.Push(rot * approachTarget_);
+    positions_.Push(droneNode->GetPosition());
+    previousPositions_.Push(droneNode->GetPosition());
+    pathParams_.Push(0.0f);
+    health_.Push(droneHealth_);
+    states_.Push(DS_APPROACHING);
+    animationLods_.Push(DAL_FULL);
+    nodes_.Push(WeakPtr<Node>(droneNode));
+    nodeIds_.Push(droneNode->GetID());
+
+    SetAnimationLod(nodes_.Size() - 1, GetAnimationLod(droneNode->GetPosition()));
+
+    return droneNode;
+}
+
+void DroneSwarmSystem::ApplyHit(Node *droneNode, float damagePoint)
+{
+    if(!droneNode)
+        return;
+
+    auto it = indices_.Find(droneNode->GetID());
+    if(it == indices_.End() || states_[it->second_] == DS_EXPIRED)
+        return;
+
+    health_[it->second_] -= damagePoint;
+}
+
+void DroneSwarmSystem::RemoveAllDrones()
+{
+    for(unsigned i = 0; i < nodes_.Size(); ++i)
+    {
+        Node* droneNode = nodes_[i];
+        if(!droneNode)
+            continue;
+
+        droneNode->Remove();
+    }
+
+    startPositions_.Clear();
+    endPositions_.Clear();
+    positions_.Clear();
+    previousPositions_.Clear();
+    pathParams_.Clear();
+    health_.Clear();
+    states_.Clear();
+    animationLods_.Clear();
+    nodes_.Clear();
+    nodeIds_.Clear();
+    indices_.Clear();
+}
+
+bool DroneSwarmSystem::IsDrone(Node *node) const
+{
+    return node && indices_.Contains(node->GetID());
+}
+
+Node* DroneSwarmSystem::GetDroneNode(unsigned index) const
+{
+    return index < nodes_.Size() ? nodes_[index].Get() : nullptr;
+}
+
+bool DroneSwarmSystem::GetSimulatedPosition(Node *droneNode, Vector3 &position) const
+{
+    if(!droneNode)
+        return false;
+
+    auto it = indices_.Find(droneNode->GetID());
+    if(it == indices_.End() || states_[it->second_] != DS_APPROACHING)
+        return false;
+
+    position = positions_[it->second_];
+    return true;
+}
+
+void DroneSwarmSystem::OnSceneSet(Scene *scene)
+{
+    if(scene)
+    {
+        //compile the drone prefab before the first wave needs it
+        GetSubsystem<PrefabCache>()->LoadPrefab(droneObjectFile_);
+
+        auto* physicsWorld = scene->GetComponent<PhysicsWorld>();
+        if(physicsWorld)
+        {
+            SubscribeToEvent(physicsWorld, E_PHYSICSPRESTEP, URHO3D_HANDLER(DroneSwarmSystem, HandlePhysicsPreStep));
+            SubscribeToEvent(physicsWorld, E_PHYSICSCOLLISION, URHO3D_HANDLER(DroneSwarmSystem, HandlePhysicsCollision));
+        }
+
+        SubscribeToEvent(scene, E_SCENEPOSTUPDATE, URHO3D_HANDLER(DroneSwarmSystem, HandleScenePostUpdate));
+    }
+    else
+    {
+        UnsubscribeFromEvent(E_SCENEPOSTUPDATE);
+        UnsubscribeFromEvent(E_PHYSICSPRESTEP);
+        UnsubscribeFromEvent(E_PHYSICSCOLLISION);
+    }
+}
+
+void DroneSwarmSystem::HandlePhysicsPreStep(StringHash eventType, VariantMap &eventData)
+{
+    using namespace PhysicsPreStep;
+
+    PerfScope scope(GetSubsystem<PerfCounters>(), "DroneSwarmSystem::Update");
+    float timeStep = eventData[P_TIMESTEP].GetFloat();
+
+    UpdateDestroyed();
+    UpdateApproach(timeStep);
+    UpdateAttacks();
+    UpdateAnimationLod();
+}
+
+void DroneSwarmSystem::HandleScenePostUpdate(StringHash eventType, VariantMap &eventData)
+{
+    auto* clock = GetScene()->GetComponent<SimulationClock>();
+    if(!clock)
+        return;
+
+    //drawn between the last two steps, the next step puts the nodes back to their simulated positions first
+    float t = clock->GetInterpolation();
+    const unsigned count = nodes_.Size();
+
+    for(unsigned i = 0; i < count; ++i)
+    {
+        if(states_[i] == DS_APPROACHING && nodes_[i])
+        {
+            nodes_[i]->SetPosition(previousPositions_[i].Lerp(positions_[i], t));
+        }
+    }
+}
+
+void DroneSwarmSystem::HandlePhysicsCollision(StringHash eventType, VariantMap &eventData)
+{
+    using namespace PhysicsCollision;
+
+    PerfScope scope(GetSubsystem<PerfCounters>(), "DroneSwarmSystem::Collision");
+    auto* nodeA = static_cast<Node*>(eventData[P_NODEA].GetPtr());
+    auto* nodeB = static_cast<Node*>(eventData[P_NODEB].GetPtr());
+
+    if(!nodeA || !nodeB)
+        return;
+
+    Node* droneNode = nodeA;
+    Node* otherNode = nodeB;
+
+    auto it = indices_.Find(droneNode->GetID());
+    if(it == indices_.End())
+    {
+        droneNode = nodeB;
+        otherNode = nodeA;
+        it = indices_.Find(droneNode->GetID());
+
+        if(it == indices_.End())
+            return;
+    }
+
+    unsigned index = it->second_;
+    if(states_[index] == DS_EXPIRED)
+        return;
+
+    //same as LowLevelDrone::HandleNodeCollision, only the player takes damage from a drone
+    auto* playerInstance = otherNode->GetComponent<ScriptInstance>();
+    if(!playerInstance || playerInstance->GetClassName() != "PlayerObject")
+        return;
+
+    playerHitMethod_.Execute(GetSubsystem<Script>(), playerInstance->GetScriptObject(), damagePoint_);
+
+    //the node is removed on the next step, outside of the physics world's collision dispatch
+    states_[index] = DS_EXPIRED;
+}
+
+void DroneSwarmSystem::UpdateApproach(float timeStep)
+{
+    const unsigned count = nodes_.Size();
+    pathStep_ = timeStep / approachTime_;
+    attackReady_.Resize(count);
+
+    //the paths are advanced on the worker threads, the nodes are only moved here
+    GetSubsystem<ParallelUpdate>()->Run(count, MIN_PARALLEL_DRONES, AdvanceApproach, this);
+
+    for(unsigned i = 0; i < count; ++i)
+    {
+        if(states_[i] == DS_APPROACHING && nodes_[i])
+        {
+            nodes_[i]->SetPosition(positions_[i]);
+        }
+    }
+}
+
+void DroneSwarmSystem::AdvanceApproach(void *data, unsigned start, unsigned end)
+{
+    auto* swarm = static_cast<DroneSwarmSystem*>(data);
+
+    for(unsigned i = start; i < end; ++i)
+    {
+        swarm->attackReady_[i] = 0;
+
+        if(swarm->states_[i] != DS_APPROACHING)
+            continue;
+
+        //the script drives the drone with a looped attribute animation, so wrap the path the same way
+        float t = swarm->pathParams_[i] + swarm->pathStep_;
+        bool wrapped = t >= 1.0f;
+        if(wrapped)
+            t -= 1.0f;
+
+        swarm->pathParams_[i] = t;
+        Vector3 position = swarm->startPositions_[i].Lerp(swarm->endPositions_[i], t);
+        //a drone that starts its path over is not drawn sliding back across the level
+        swarm->previousPositions_[i] = wrapped ? position : swarm->positions_[i];
+        swarm->positions_[i] = position;
+
+        //player is assumed to be at the origin, as in LowLevelDrone::FixedUpdate
+        swarm->attackReady_[i] = swarm->health_[i] > 0.0f && swarm->positions_[i].LengthSquared() <= swarm->attackDistance_;
+    }
+}
+
+void DroneSwarmSystem::UpdateAttacks()
+{
+    const unsigned count = nodes_.Size();
+
+    for(unsigned i = 0; i < count; ++i)
+    {
+        if(attackReady_[i])
+        {
+            StartAttack(i);
+        }
+    }
+}
+
+void DroneSwarmSystem::UpdateAnimationLod()
+{
+    const unsigned count = nodes_.Size();
+
+    for(unsigned i = 0; i < count; ++i)
+    {
+        if(states_[i] != DS_APPROACHING)
+            continue;
+
+        DroneAnimationLod lod = GetAnimationLod(positions_[i]);
+        if(lod != animationLods_[i])
+            SetAnimationLod(i, lod);
+    }
+}
+
+DroneAnimationLod DroneSwarmSystem::GetAnimationLod(const Vector3 &position) const
+{
+    //player is assumed to be at the origin, as in UpdateAttacks
+    float distance = position.LengthSquared();
+
+    if(distance > frozenAnimationDistance_ * frozenAnimationDistance_)
+        return DAL_FROZEN;
+    if(distance > reducedAnimationDistance_ * reducedAnimationDistance_)
+        return DAL_REDUCED;
+
+    return DAL_FULL;
+}
+
+void DroneSwarmSystem::SetAnimationLod(unsigned index, DroneAnimationLod lod)
+{
+    animationLods_[index] = lod;
+
+    Node* droneNode = nodes_[index];
+    if(!droneNode)
+        return;
+
+    auto* animController = droneNode->GetComponent<AnimationController>();
+    if(animController)
+    {
+        if(lod == DAL_FROZEN)
+        {
+            //skip to the pose the arm clips end in, after which the skeleton is not touched again until enabled
+            const Vector<AnimationControl>& animations = animController->GetAnimations();
+            for(unsigned i = 0; i < animations.Size(); ++i)
+            {
+                animController->SetTime(animations[i].name_, animController->GetLength(animations[i].name_));
+            }
+        }
+
+        animController->SetEnabled(lod != DAL_FROZEN);
+    }
+
+    //the models skip animation updates with their distance to the camera, more so at a lower bias
+    PODVector<AnimatedModel*> models;
+    droneNode->GetComponents<AnimatedModel>(models);
+    for(unsigned i = 0; i < models.Size(); ++i)
+    {
+        models[i]->SetAnimationLodBias(lod == DAL_FULL ? 1.0f : reducedAnimationLodBias_);
+    }
+}
+
+void DroneSwarmSystem::UpdateDestroyed()
+{
+    //iterate backwards so that the swap on removal only moves drones that were already checked
+    for(unsigned i = nodes_.Size(); i-- > 0;)
+    {
+        if(!nodes_[i] || states_[i] == DS_EXPIRED)
+        {
+            RemoveDrone(i);
+        }
+        else if(health_[i] <= 0.0f)
+        {
+            OnDroneDestroyed(i);
+            RemoveDrone(i);
+        }
+    }
+}
+
+void DroneSwarmSystem::StartAttack(unsigned index)
+{
+    Node* droneNode = nodes_[index];
+    states_[index] = DS_ATTACKING;
+
+    if(!droneNode)
+        return;
+
+    //attacking drones are close to the player and are animated in full from here on
+    SetAnimationLod(index, DAL_FULL);
+
+    auto* animController = droneNode->GetComponent<AnimationController>();
+    if(animController)
+    {
+        animController->PlayExclusive("Models/close_arm.ani", 0, false);
+    }
+
+    auto* objectBody = droneNode->GetComponent<RigidBody>();
+    if(objectBody)
+    {
+        objectBody->SetKinematic(false);
+        objectBody->SetLinearVelocity(droneNode->GetRotation() * attackVelocity_);
+    }
+}
+
+void DroneSwarmSystem::OnDroneDestroyed(unsigned index)
+{
+    DroneDestroyed::Data event;
+    event.dronePoint_ = dronePoint_;
+    GetSubsystem<GameEventChannel>()->Post(event);
+
+    if(nodes_[index])
+    {
+        SpawnExplosion(nodes_[index]->GetWorldPosition());
+    }
+}
+
+void DroneSwarmSystem::RemoveDrone(unsigned index)
+{
+    Node* droneNode = nodes_[index];
+    indices_.Erase(nodeIds_[index]);
+
+    if(droneNode)
+    {
+        droneNode->Remove();
+    }
+
+    unsigned last = nodes_.Size() - 1;
+    if(index != last)
+    {
+        startPositions_[index] = startPositions_[last];
+        endPositions_[index] = endPositions_[last];
+        positions_[index] = positions_[last];
+        previousPositions_[index] = previousPositions_[last];
+        pathParams_[index] = pathParams_[last];
+        health_[index] = health_[last];
+        states_[index] = states_[last];
+        animationLods_[index] = animationLods_[last];
+        nodes_[index] = nodes_[last];
+        nodeIds_[index] = nodeIds_[last];
+
+        indices_[nodeIds_[index]] = index;
+    }
+
+    startPositions_.Pop();
+    endPositions_.Pop();
+    positions_.Pop();
+    previousPositions_.Pop();
+    pathParams_.Pop();
+    health_.Pop();
+    states_.Pop();
+    animationLods_.Pop();
+    nodes_.Pop();
+    nodeIds_.Pop();
+}
+
+void DroneSwarmSystem::SpawnExplosion(const Vector3 &position)
+{
+    auto* nodePool = GetScene()->GetComponent<NodePool>();
+    if(nodePool && nodePool->Acquire("SimpleExplosion", position, Quaternion::IDENTITY))
+        return;
+
+    auto* cache = GetSubsystem<ResourceCache>();
+
+    Node* explosionNode = GetScene()->CreateChild("ExplosionNode");
+    explosionNode->SetWorldPosition(position);
+
+    auto* instance = explosionNode->CreateComponent<ScriptInstance>();
+    instance->CreateObject(cache->GetResource<ScriptFile>("Scripts/GameObjects.as"), "SimpleExplosion");
+    instance->Execute("void OnAcquired()");
+}
@@ -0,0 +1,148 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef DRONESWARMSYSTEM_H
+#define DRONESWARMSYSTEM_H
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Scene/Component.h>
+#include <Urho3D/Scene/Node.h>
+#include <Urho3D/Container/HashMap.h>
+
+#include "ScriptMethod.h"
+
+using namespace Urho3D;
+
+/// Drone simulation states.
+enum DroneState
+{
+    DS_APPROACHING = 0,
+    DS_ATTACKING,
+    DS_EXPIRED
+};
+
+/// Drone animation detail levels by distance to the player.
+enum DroneAnimationLod
+{
+    DAL_FULL = 0,
+    DAL_REDUCED,
+    DAL_FROZEN
+};
+
+/// Simulates all low level drones of a scene natively. Mirrors the LowLevelDrone script object in
+/// Drone.as, but keeps the drone state in parallel arrays that are advanced in one pass per physics step.
+class DroneSwarmSystem : public Component
+{
+    URHO3D_OBJECT(DroneSwarmSystem, Component)
+
+public:
+    DroneSwarmSystem(Context* context);
+
+    static void RegisterObject(Context* context);
+
+    /// Spawn a drone at a random bearing on the spawn ring and return its node.
+    Node* SpawnDrone();
+    /// Spawn a drone at a bearing in degrees on the spawn ring and return its node.
+    Node* SpawnDrone(float bearing);
+    /// Apply damage to the drone owned by the node. Destruction is handled on the next physics step.
+    void ApplyHit(Node* droneNode, float damagePoint);
+    /// Remove all drones.
+    void RemoveAllDrones();
+    /// Return whether the node is a drone owned by this system.
+    bool IsDrone(Node* node) const;
+    /// Return number of live drones.
+    unsigned GetDroneCount() const { return nodes_.Size(); }
+    /// Return drone node by index.
+    Node* GetDroneNode(unsigned index) const;
+    /// Return the simulated position of an approaching drone, whose node is drawn between the last two steps.
+    /// Return false if the node is not an approaching drone of this system.
+    bool GetSimulatedPosition(Node* droneNode, Vector3& position) const;
+
+protected:
+    void OnSceneSet(Scene* scene) override;
+
+private:
+    void HandlePhysicsPreStep(StringHash eventType, VariantMap& eventData);
+    void HandlePhysicsCollision(StringHash eventType, VariantMap& eventData);
+    /// Place the approaching drones between their last two simulated positions for rendering.
+    void HandleScenePostUpdate(StringHash eventType, VariantMap& eventData);
+
+    /// Advance the approach path of all drones that have not attacked yet.
+    void UpdateApproach(float timeStep);
+    /// Advance the approach paths of a range of drones and check their distance to the player, run in parallel.
+    static void AdvanceApproach(void* data, unsigned start, unsigned end);
+    /// Start the attack dive of every drone that came close enough to the player.
+    void UpdateAttacks();
+    /// Destroy every drone that ran out of health or hit the player.
+    void UpdateDestroyed();
+    /// Move approaching drones to the animation detail level of their distance.
+    void UpdateAnimationLod();
+    /// Return the animation detail level for a drone position.
+    DroneAnimationLod GetAnimationLod(const Vector3& position) const;
+    /// Apply an animation detail level to the models and the animation controller of a drone.
+    void SetAnimationLod(unsigned index, DroneAnimationLod lod);
+
+    void StartAttack(unsigned index);
+    void OnDroneDestroyed(unsigned index);
+    /// Remove drone by index, moving the last drone into its slot.
+    void RemoveDrone(unsigned index);
+    void SpawnExplosion(const Vector3& position);
+
+    float droneHealth_;
+    int dronePoint_;
+    float damagePoint_;
+    /// Time for a drone to travel its whole approach path.
+    float approachTime_;
+    float attackDistance_;
+    Vector3 spawnOffset_;
+    Vector3 approachTarget_;
+    Vector3 attackVelocity_;
+    String droneObjectFile_;
+    /// Distance beyond which the drone animations update at a reduced rate.
+    float reducedAnimationDistance_;
+    /// Distance beyond which the drone animations are frozen in their final pose.
+    float frozenAnimationDistance_;
+    /// Animation LOD bias of the models at the reduced detail level.
+    float reducedAnimationLodBias_;
+
+    PODVector<Vector3> startPositions_;
+    PODVector<Vector3> endPositions_;
+    PODVector<Vector3> positions_;
+    PODVector<Vector3> previousPositions_;
+    PODVector<float> pathParams_;
+    PODVector<float> health_;
+    PODVector<unsigned char> states_;
+    PODVector<unsigned char> animationLods_;
+    /// Whether each drone came close enough to attack during the current step.
+    PODVector<unsigned char> attackReady_;
+    /// Path advance of the current step.
+    float pathStep_;
+    Vector<WeakPtr<Node> > nodes_;
+    PODVector<unsigned> nodeIds_;
+
+    /// Node ID to array index lookup.
+    HashMap<unsigned, unsigned> indices_;
+    /// OnHit method of the player script object.
+    CachedScriptMethod playerHitMethod_;
+};
+
+#endif // DRONESWARMSYSTEM_H
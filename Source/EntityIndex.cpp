@@ -0,0 +1,328 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Scene/Scene.h>
+#include <Urho3D/Scene/SceneEvents.h>
+#include <Urho3D/AngelScript/ScriptInstance.h>
+
+#include "EntityIndex.h"
+
+void EntityIndex::Group::Add(Node* node)
+{
+    if(indices_.Contains(node->GetID()))
+        return;
+
+    indices_[node->GetID()] = nodes_.Size();
+    nodes_.Push(WeakPtr<Node>(node));
+    nodeIds_.Push(node->GetID());
+}
+
+void EntityIndex::Group::Remove(unsigned nodeId)
+{
+    auto it = indices_.Find(nodeId);
+    if(it == indices_.End())
+        return;
+
+    unsigned index = it->second_;
+    unsigned last = nodes_.Size() - 1;
+    indices_.Erase(it);
+
+    if(index != last)
+    {
+        nodes_[index] = nodes_[last];
+        nodeIds_[index] = nodeIds_[last];
+        indices_[nodeIds_[index]] = index;
+    }
+
+    nodes_.Pop();
+    nodeIds_.Pop();
+}
+
+void EntityIndex::Group::Clear()
+{
+    nodes_.Clear();
+    nodeIds_.Clear();
+    indices_.Clear();
+}
+
+EntityIndex::EntityIndex(Context *context) : Component(context)
+{
+
+}
+
+void EntityIndex::RegisterObject(Context *context)
+{
+    context->RegisterFactory<EntityIndex>();
+}
+
+unsigned EntityIndex::GetTaggedCount(const String &tag) const
+{
+    return GetGroup(tagGroups_, tag).nodes_.Size();
+}
+
+Node* EntityIndex::GetTaggedNode(const String &tag, unsigned index) const
+{
+    const Group& group = GetGroup(tagGroups_, tag);
+    return index < group.nodes_.Size() ? group.nodes_[index].Get() : nullptr;
+}
+
+const Vector<WeakPtr<Node> >& EntityIndex::GetTaggedNodes(const String &tag) const
+{
+    return GetGroup(tagGroups_, tag).nodes_;
+}
+
+unsigned EntityIndex::GetScriptCount(const String &className)
+{
+    UpdatePendingScripts();
+    return GetGroup(classGroups_, className).nodes_.Size();
+}
+
+Node* EntityIndex::GetScriptNode(const String &className, unsigned index)
+{
+    UpdatePendingScripts();
+    const Group& group = GetGroup(classGroups_, className);
+    return index < group.nodes_.Size() ? group.nodes_[index].Get() : nullptr;
+}
+
+const Vector<WeakPtr<Node> >& EntityIndex::GetScriptNodes(const String &className)
+{
+    UpdatePendingScripts();
+    return GetGroup(classGroups_, className).nodes_;
+}
+
+unsigned EntityIndex::GetScriptedCount()
+{
+    return scriptedNodes_.nodes_.Size();
+}
+
+Node* EntityIndex::GetScriptedNode(unsigned index)
+{
+    return index < scriptedNodes_.nodes_.Size() ? scriptedNodes_.nodes_[index].Get() : nullptr;
+}
+
+const Vector<WeakPtr<Node> >& EntityIndex::GetScriptedNodes()
+{
+    return scriptedNodes_.nodes_;
+}
+
+void EntityIndex::OnSceneSet(Scene *scene)
+{
+    tagGroups_.Clear();
+    classGroups_.Clear();
+    scriptedNodes_.Clear();
+    pendingScripts_.Clear();
+
+    if(scene)
+    {
+        //the scene is only walked here, after that the index follows the scene events
+        const Vector<SharedPtr<Node> >& children = scene->GetChildren();
+        for(unsigned i = 0; i < children.Size(); ++i)
+        {
+            AddNode(children[i]);
+        }
+
+        SubscribeToEvent(scene, E_NODEADDED, URHO3D_HANDLER(EntityIndex, HandleNodeAdded));
+        SubscribeToEvent(scene, E_NODEREMOVED, URHO3D_HANDLER(EntityIndex, HandleNodeRemoved));
+        SubscribeToEvent(scene, E_NODETAGADDED, URHO3D_HANDLER(EntityIndex, HandleNodeTagAdded));
+        SubscribeToEvent(scene, E_NODETAGREMOVED, URHO3D_HANDLER(EntityIndex, HandleNodeTagRemoved));
+        SubscribeToEvent(scene, E_COMPONENTADDED, URHO3D_HANDLER(EntityIndex, HandleComponentAdded));
+        SubscribeToEvent(scene, E_COMPONENTREMOVED, URHO3D_HANDLER(EntityIndex, HandleComponentRemoved));
+    }
+    else
+    {
+        UnsubscribeFromEvent(E_NODEADDED);
+        UnsubscribeFromEvent(E_NODEREMOVED);
+        UnsubscribeFromEvent(E_NODETAGADDED);
+        UnsubscribeFromEvent(E_NODETAGREMOVED);
+        UnsubscribeFromEvent(E_COMPONENTADDED);
+        UnsubscribeFromEvent(E_COMPONENTREMOVED);
+    }
+}
+
+void EntityIndex::HandleNodeAdded(StringHash eventType, VariantMap &eventData)
+{
+    using namespace NodeAdded;
+
+    AddNode(static_cast<Node*>(eventData[P_NODE].GetPtr()));
+}
+
+void EntityIndex::HandleNodeRemoved(StringHash eventType, VariantMap &eventData)
+{
+    using namespace NodeRemoved;
+
+    RemoveNode(static_cast<Node*>(eventData[P_NODE].GetPtr()));
+}
+
+void EntityIndex::HandleNodeTagAdded(StringHash eventType, VariantMap &eventData)
+{
+    using namespace NodeTagAdded;
+
+    tagGroups_[eventData[P_TAG].GetString()].Add(static_cast<Node*>(eventData[P_NODE].GetPtr()));
+}
+
+void EntityIndex::HandleNodeTagRemoved(StringHash eventType, VariantMap &eventData)
+{
+    using namespace NodeTagRemoved;
+
+    auto it = tagGroups_.Find(eventData[P_TAG].GetString());
+    if(it != tagGroups_.End())
+    {
+        it->second_.Remove(static_cast<Node*>(eventData[P_NODE].GetPtr())->GetID());
+    }
+}
+
+void EntityIndex::HandleComponentAdded(StringHash eventType, VariantMap &eventData)
+{
+    using namespace ComponentAdded;
+
+    auto* component = static_cast<Component*>(eventData[P_COMPONENT].GetPtr());
+    if(component->GetType() != ScriptInstance::GetTypeStatic())
+        return;
+
+    scriptedNodes_.Add(static_cast<Node*>(eventData[P_NODE].GetPtr()));
+    pendingScripts_.Push(WeakPtr<ScriptInstance>(static_cast<ScriptInstance*>(component)));
+}
+
+void EntityIndex::HandleComponentRemoved(StringHash eventType, VariantMap &eventData)
+{
+    using namespace ComponentRemoved;
+
+    auto* component = static_cast<Component*>(eventData[P_COMPONENT].GetPtr());
+    if(component->GetType() != ScriptInstance::GetTypeStatic())
+        return;
+
+    //the component is still attached while the event is sent
+    auto* node = static_cast<Node*>(eventData[P_NODE].GetPtr());
+    auto it = classGroups_.Find(static_cast<ScriptInstance*>(component)->GetClassName());
+    if(it != classGroups_.End())
+    {
+        it->second_.Remove(node->GetID());
+    }
+
+    PODVector<ScriptInstance*> instances;
+    node->GetComponents<ScriptInstance>(instances);
+    if(instances.Size() <= 1)
+    {
+        scriptedNodes_.Remove(node->GetID());
+    }
+}
+
+void EntityIndex::AddNode(Node *node)
+{
+    const StringVector& tags = node->GetTags();
+    for(unsigned i = 0; i < tags.Size(); ++i)
+    {
+        tagGroups_[tags[i]].Add(node);
+    }
+
+    const Vector<SharedPtr<Component> >& components = node->GetComponents();
+    for(unsigned i = 0; i < components.Size(); ++i)
+    {
+        if(components[i]->GetType() != ScriptInstance::GetTypeStatic())
+            continue;
+
+        auto* instance = static_cast<ScriptInstance*>(components[i].Get());
+        scriptedNodes_.Add(node);
+
+        if(instance->GetClassName().Empty())
+        {
+            pendingScripts_.Push(WeakPtr<ScriptInstance>(instance));
+        }
+        else
+        {
+            classGroups_[instance->GetClassName()].Add(node);
+        }
+    }
+
+    const Vector<SharedPtr<Node> >& children = node->GetChildren();
+    for(unsigned i = 0; i < children.Size(); ++i)
+    {
+        AddNode(children[i]);
+    }
+}
+
+void EntityIndex::RemoveNode(Node *node)
+{
+    unsigned nodeId = node->GetID();
+
+    const StringVector& tags = node->GetTags();
+    for(unsigned i = 0; i < tags.Size(); ++i)
+    {
+        auto it = tagGroups_.Find(tags[i]);
+        if(it != tagGroups_.End())
+        {
+            it->second_.Remove(nodeId);
+        }
+    }
+
+    const Vector<SharedPtr<Component> >& components = node->GetComponents();
+    for(unsigned i = 0; i < components.Size(); ++i)
+    {
+        if(components[i]->GetType() != ScriptInstance::GetTypeStatic())
+            continue;
+
+        auto it = classGroups_.Find(static_cast<ScriptInstance*>(components[i].Get())->GetClassName());
+        if(it != classGroups_.End())
+        {
+            it->second_.Remove(nodeId);
+        }
+    }
+
+    scriptedNodes_.Remove(nodeId);
+
+    const Vector<SharedPtr<Node> >& children = node->GetChildren();
+    for(unsigned i = 0; i < children.Size(); ++i)
+    {
+        RemoveNode(children[i]);
+    }
+}
+
+void EntityIndex::UpdatePendingScripts()
+{
+    if(pendingScripts_.Empty())
+        return;
+
+    Scene* scene = GetScene();
+
+    for(unsigned i = 0; i < pendingScripts_.Size(); ++i)
+    {
+        ScriptInstance* instance = pendingScripts_[i];
+
+        //skip instances that were removed, or whose node left the scene, before they were classified
+        if(!instance || !instance->GetNode() || instance->GetNode()->GetScene() != scene)
+            continue;
+
+        if(!instance->GetClassName().Empty())
+        {
+            classGroups_[instance->GetClassName()].Add(instance->GetNode());
+        }
+    }
+
+    pendingScripts_.Clear();
+}
+
+const EntityIndex::Group& EntityIndex::GetGroup(const HashMap<StringHash, Group> &groups, StringHash key) const
+{
+    auto it = groups.Find(key);
+    return it != groups.End() ? it->second_ : emptyGroup_;
+}
@@ -0,0 +1,111 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef ENTITYINDEX_H
+#define ENTITYINDEX_H
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Scene/Component.h>
+#include <Urho3D/Scene/Node.h>
+#include <Urho3D/Container/HashMap.h>
+
+namespace Urho3D
+{
+    class ScriptInstance;
+}
+
+using namespace Urho3D;
+
+/// Indexes the nodes of a scene by tag and by script class. The index follows the scene's node, tag and
+/// component events, so counts are constant time and each group can be iterated without walking the scene.
+class EntityIndex : public Component
+{
+    URHO3D_OBJECT(EntityIndex, Component)
+
+public:
+    EntityIndex(Context* context);
+
+    static void RegisterObject(Context* context);
+
+    /// Return number of nodes with the tag.
+    unsigned GetTaggedCount(const String& tag) const;
+    /// Return node with the tag by index.
+    Node* GetTaggedNode(const String& tag, unsigned index) const;
+    /// Return nodes with the tag.
+    const Vector<WeakPtr<Node> >& GetTaggedNodes(const String& tag) const;
+
+    /// Return number of nodes with a script object of the class.
+    unsigned GetScriptCount(const String& className);
+    /// Return node with a script object of the class by index.
+    Node* GetScriptNode(const String& className, unsigned index);
+    /// Return nodes with a script object of the class.
+    const Vector<WeakPtr<Node> >& GetScriptNodes(const String& className);
+
+    /// Return number of nodes with any script object.
+    unsigned GetScriptedCount();
+    /// Return node with any script object by index.
+    Node* GetScriptedNode(unsigned index);
+    /// Return nodes with any script object.
+    const Vector<WeakPtr<Node> >& GetScriptedNodes();
+
+protected:
+    void OnSceneSet(Scene* scene) override;
+
+private:
+    /// Contiguous node set with constant time insertion and swap removal.
+    struct Group
+    {
+        void Add(Node* node);
+        void Remove(unsigned nodeId);
+        void Clear();
+
+        Vector<WeakPtr<Node> > nodes_;
+        PODVector<unsigned> nodeIds_;
+        /// Node ID to group index lookup.
+        HashMap<unsigned, unsigned> indices_;
+    };
+
+    void HandleNodeAdded(StringHash eventType, VariantMap& eventData);
+    void HandleNodeRemoved(StringHash eventType, VariantMap& eventData);
+    void HandleNodeTagAdded(StringHash eventType, VariantMap& eventData);
+    void HandleNodeTagRemoved(StringHash eventType, VariantMap& eventData);
+    void HandleComponentAdded(StringHash eventType, VariantMap& eventData);
+    void HandleComponentRemoved(StringHash eventType, VariantMap& eventData);
+
+    /// Index a node and its children.
+    void AddNode(Node* node);
+    /// Remove a node and its children from every group.
+    void RemoveNode(Node* node);
+    /// Index the script instances whose class was not known when they were added.
+    void UpdatePendingScripts();
+
+    const Group& GetGroup(const HashMap<StringHash, Group>& groups, StringHash key) const;
+
+    HashMap<StringHash, Group> tagGroups_;
+    HashMap<StringHash, Group> classGroups_;
+    Group scriptedNodes_;
+    /// Script instances are added before their class is set, so they are classified on the next query.
+    Vector<WeakPtr<ScriptInstance> > pendingScripts_;
+    Group emptyGroup_;
+};
+
+#endif // ENTITYINDEX_H
@@ -24,6 +24,8 @@
 #define EVENTS_AND_DEFS_H
 
 #include <Urho3D/Core/Object.h>
+#include <Urho3D/Math/Quaternion.h>
+#include <Urho3D/Math/Vector3.h>
 
 //Level Status
 const int LSTATUS_NORMAL = 0;
@@ -49,50 +51,85 @@ const int EVT_JOYSTICK_HATMOVE = 8;
 //Application Event IDs
 const int EVT_WEB_WINDOW_RESIZED = 9;
 
-//Custom Events
+//Number of Level Manager Event ID slots (IDs are used as direct indices)
+const int EVT_COUNT = 10;
+
+//Gameplay Event IDs, index the queues of the GameEventChannel
+enum GameEventId
+{
+    GE_PLAYERHIT = 0,
+    GE_PLAYERHEALTHUPDATE,
+    GE_PLAYERDESTROYED,
+    GE_DRONEDESTROYED,
+    GE_PLAYERROTATION,
+    GE_COUNTFINISHED,
+    GE_ACTIVATEWEAPON,
+    GE_COUNT
+};
+
+//Custom Events, each with the plain data payload posted to the GameEventChannel
 URHO3D_EVENT(E_PLAYERHIT, PlayerHit)
 {
-
+    struct Data
+    {
+        static constexpr GameEventId ID = GE_PLAYERHIT;
+    };
 }
 
 URHO3D_EVENT(E_PLAYERHEALTHUPDATE, PlayerHealthUpdate)
 {
-    URHO3D_PARAM(P_CURRENTHEALTHFRACTION,CurrentHealthFraction );
+    struct Data
+    {
+        static constexpr GameEventId ID = GE_PLAYERHEALTHUPDATE;
+        float currentHealthFraction_;
+    };
 }
 
 URHO3D_EVENT(E_PLAYERDESTROYED, PlayerDestroyed)
 {
-    URHO3D_PARAM(P_CAMPOSITION,CamPosition );
-    URHO3D_PARAM(P_CAMROTATION,CamRotation );
-    URHO3D_PARAM(P_PLAYERPOSITION,PlayerPosition );
-    URHO3D_PARAM(P_PLAYERROTATION,PlayerRotation );
+    struct Data
+    {
+        static constexpr GameEventId ID = GE_PLAYERDESTROYED;
+        Urho3D::Vector3 camPosition_;
+        Urho3D::Quaternion camRotation_;
+        Urho3D::Vector3 playerPosition_;
+        Urho3D::Quaternion playerRotation_;
+    };
 }
 
 URHO3D_EVENT(E_DRONEDESTROYED, DroneDestroyed)
 {
-    URHO3D_PARAM(P_DRONEPOINT, DronePoint);
-}
-
-
-URHO3D_EVENT(E_SOUNDGENERATED, SoundGenerated)
-{
-    URHO3D_PARAM(P_SOUNDNODE, SoundNode);
-    URHO3D_PARAM(P_SOUNDNAME, SoundName);
+    struct Data
+    {
+        static constexpr GameEventId ID = GE_DRONEDESTROYED;
+        int dronePoint_;
+    };
 }
 
 URHO3D_EVENT(E_PLAYERROTATION, PlayerRotation)
 {
-    URHO3D_PARAM(P_DX, DX);
-    URHO3D_PARAM(P_DY, DY);
+    struct Data
+    {
+        static constexpr GameEventId ID = GE_PLAYERROTATION;
+        int dx_;
+        int dy_;
+    };
 }
 
 URHO3D_EVENT(E_COUNTFINISHED, CountFinished)
 {
+    struct Data
+    {
+        static constexpr GameEventId ID = GE_COUNTFINISHED;
+    };
 }
 
 URHO3D_EVENT(E_ACTIVATEWEAPON, ActivateWeapon)
 {
-
+    struct Data
+    {
+        static constexpr GameEventId ID = GE_ACTIVATEWEAPON;
+    };
 }
 
 #endif // EVENTS_AND_DEFS_H
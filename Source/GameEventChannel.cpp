@@ -0,0 +1,360 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <cassert>
+#include <cstring>
+
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Core/CoreEvents.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/AngelScript/Script.h>
+
+#include <AngelScript/angelscript.h>
+
+#include "PerfCounters.h"
+#include "GameEventChannel.h"
+
+//Number of events per type the queues have room for before they grow
+static const unsigned INITIAL_EVENT_CAPACITY = 64;
+//Limit of delivery passes per flush, events posted by the handlers of the last pass wait for the next flush
+static const unsigned MAX_FLUSH_PASSES = 4;
+
+GameEventChannel::GameEventChannel(Context *context) : Object(context)
+, flushing_(false)
+{
+    RegisterEvent<PlayerHit::Data>("");
+    RegisterEvent<PlayerHealthUpdate::Data>("PlayerHealthUpdateEvent");
+    RegisterEvent<PlayerDestroyed::Data>("PlayerDestroyedEvent");
+    RegisterEvent<DroneDestroyed::Data>("DroneDestroyedEvent");
+    RegisterEvent<PlayerRotation::Data>("PlayerRotationEvent");
+    RegisterEvent<CountFinished::Data>("");
+    RegisterEvent<ActivateWeapon::Data>("");
+
+    //input driven events reach the gameplay before the scene update, the rest right after it
+    SubscribeToEvent(E_UPDATE, URHO3D_HANDLER(GameEventChannel, HandleUpdate));
+    SubscribeToEvent(E_POSTUPDATE, URHO3D_HANDLER(GameEventChannel, HandlePostUpdate));
+}
+
+GameEventChannel::~GameEventChannel()
+{
+    for(unsigned i = 0; i < GE_COUNT; ++i)
+    {
+        PODVector<ScriptSubscriber>& subscribers = queues_[i].scriptSubscribers_;
+        for(unsigned j = 0; j < subscribers.Size(); ++j)
+        {
+            ReleaseScriptSubscriber(subscribers[j]);
+        }
+    }
+}
+
+template <class T> void GameEventChannel::RegisterEvent(const char* scriptTypeName)
+{
+    Queue& queue = queues_[T::ID];
+    queue.payloadSize_ = sizeof(T);
+    queue.hasPayload_ = !std::is_empty<T>::value;
+    if(queue.hasPayload_)
+    {
+        queue.scriptParameter_ = "const " + String(scriptTypeName) + "&in";
+    }
+
+    queue.pending_.Reserve(INITIAL_EVENT_CAPACITY * sizeof(T));
+    queue.delivering_.Reserve(INITIAL_EVENT_CAPACITY * sizeof(T));
+}
+
+void GameEventChannel::Unsubscribe(Object *receiver)
+{
+    for(unsigned i = 0; i < GE_COUNT; ++i)
+    {
+        Vector<SharedPtr<GameEventHandler> >& handlers = queues_[i].handlers_;
+        for(unsigned j = 0; j < handlers.Size(); ++j)
+        {
+            if(handlers[j] && handlers[j]->GetReceiver() == receiver)
+            {
+                handlers[j].Reset();
+            }
+        }
+
+        if(!flushing_)
+        {
+            PruneSubscribers(queues_[i]);
+        }
+    }
+}
+
+bool GameEventChannel::Post(GameEventId id)
+{
+    if(id < 0 || id >= GE_COUNT || queues_[id].hasPayload_)
+    {
+        URHO3D_LOGERROR("Game event " + String((int)id) + " can not be posted without payload");
+        return false;
+    }
+
+    //the placeholder byte of an empty payload is never read
+    Queue& queue = queues_[id];
+    queue.pending_.Resize(queue.pending_.Size() + queue.payloadSize_);
+    return true;
+}
+
+bool GameEventChannel::SubscribeScript(GameEventId id, asIScriptObject *object, const String &handlerName)
+{
+    if(!object || id < 0 || id >= GE_COUNT)
+        return false;
+
+    Queue& queue = queues_[id];
+    String declaration = "void " + handlerName + "(" + queue.scriptParameter_ + ")";
+    asIScriptFunction* method = object->GetObjectType()->GetMethodByDecl(declaration.CString());
+    if(!method)
+    {
+        URHO3D_LOGERROR("Game event handler " + declaration + " not found in class " + String(object->GetObjectType()->GetName()));
+        return false;
+    }
+
+    //subscribing again replaces the handler method
+    for(unsigned i = 0; i < queue.scriptSubscribers_.Size(); ++i)
+    {
+        ScriptSubscriber& subscriber = queue.scriptSubscribers_[i];
+        if(subscriber.object_ == object && !subscriber.weakRefFlag_->Get())
+        {
+            subscriber.method_ = method;
+            return true;
+        }
+    }
+
+    ScriptSubscriber subscriber;
+    subscriber.object_ = object;
+    subscriber.weakRefFlag_ = object->GetWeakRefFlag();
+    subscriber.weakRefFlag_->AddRef();
+    subscriber.method_ = method;
+    queue.scriptSubscribers_.Push(subscriber);
+
+    return true;
+}
+
+void GameEventChannel::UnsubscribeScript(GameEventId id, asIScriptObject *object)
+{
+    if(id < 0 || id >= GE_COUNT)
+        return;
+
+    PODVector<ScriptSubscriber>& subscribers = queues_[id].scriptSubscribers_;
+    for(unsigned i = 0; i < subscribers.Size(); ++i)
+    {
+        if(subscribers[i].object_ == object)
+        {
+            ReleaseScriptSubscriber(subscribers[i]);
+        }
+    }
+
+    if(!flushing_)
+    {
+        PruneSubscribers(queues_[id]);
+    }
+}
+
+void GameEventChannel::UnsubscribeScript(asIScriptObject *object)
+{
+    for(unsigned i = 0; i < GE_COUNT; ++i)
+    {
+        UnsubscribeScript((GameEventId)i, object);
+    }
+}
+
+void GameEventChannel::Flush()
+{
+    //a handler flushing again would deliver the batch that is being delivered
+    if(flushing_)
+        return;
+
+    PerfScope scope(GetSubsystem<PerfCounters>(), "GameEventChannel::Flush");
+    flushing_ = true;
+
+    for(unsigned pass = 0; pass < MAX_FLUSH_PASSES; ++pass)
+    {
+        bool delivered = false;
+
+        for(unsigned i = 0; i < GE_COUNT; ++i)
+        {
+            Queue& queue = queues_[i];
+            if(queue.pending_.Empty())
+                continue;
+
+            queue.pending_.Swap(queue.delivering_);
+            Deliver(queue);
+            queue.delivering_.Clear();
+            delivered = true;
+        }
+
+        if(!delivered)
+            break;
+    }
+
+    flushing_ = false;
+
+    for(unsigned i = 0; i < GE_COUNT; ++i)
+    {
+        PruneSubscribers(queues_[i]);
+    }
+}
+
+unsigned GameEventChannel::GetPendingCount() const
+{
+    unsigned count = 0;
+
+    for(unsigned i = 0; i < GE_COUNT; ++i)
+    {
+        count += queues_[i].pending_.Size() / queues_[i].payloadSize_;
+    }
+
+    return count;
+}
+
+void GameEventChannel::PostData(GameEventId id, const void *data, unsigned size)
+{
+    Queue& queue = queues_[id];
+    assert(size == queue.payloadSize_);
+
+    unsigned offset = queue.pending_.Size();
+    queue.pending_.Resize(offset + size);
+    memcpy(&queue.pending_[offset], data, size);
+}
+
+void GameEventChannel::AddHandler(GameEventId id, GameEventHandler *handler)
+{
+    queues_[id].handlers_.Push(SharedPtr<GameEventHandler>(handler));
+}
+
+void GameEventChannel::Deliver(Queue &queue)
+{
+    unsigned count = queue.delivering_.Size() / queue.payloadSize_;
+
+    //handlers may subscribe or unsubscribe while the batch is delivered, so the list is indexed afresh each time
+    for(unsigned i = 0; i < queue.handlers_.Size(); ++i)
+    {
+        SharedPtr<GameEventHandler> handler(queue.handlers_[i]);
+        if(handler && handler->GetReceiver())
+        {
+            handler->Invoke(queue.delivering_.Buffer(), count);
+        }
+    }
+
+    if(!queue.scriptSubscribers_.Empty())
+    {
+        DeliverToScript(queue, count);
+    }
+}
+
+void GameEventChannel::DeliverToScript(Queue &queue, unsigned count)
+{
+    auto* script = GetSubsystem<Script>();
+    if(!script)
+        return;
+
+    for(unsigned i = 0; i < queue.scriptSubscribers_.Size(); ++i)
+    {
+        ScriptSubscriber subscriber = queue.scriptSubscribers_[i];
+        if(!subscriber.object_)
+            continue;
+
+        if(subscriber.weakRefFlag_->Get())
+        {
+            ReleaseScriptSubscriber(queue.scriptSubscribers_[i]);
+            continue;
+        }
+
+        //the object is kept alive for the whole batch, as a handler may remove the node that owns it
+        subscriber.object_->AddRef();
+
+        //same direct call as LevelManager::ExecuteScriptMethod, the payload is handed over by reference
+        asIScriptContext* context = script->GetScriptFileContext();
+        script->IncScriptNestingLevel();
+
+        for(unsigned j = 0; j < count; ++j)
+        {
+            //stop when the handler has unsubscribed itself
+            if(!queue.scriptSubscribers_[i].object_ || context->Prepare(subscriber.method_) < 0)
+                break;
+
+            context->SetObject(subscriber.object_);
+            if(queue.hasPayload_)
+            {
+                context->SetArgAddress(0, &queue.delivering_[j * queue.payloadSize_]);
+            }
+
+            //log the exception like the engine's own script calls, a failing handler must not go unnoticed
+            if(context->Execute() == asEXECUTION_EXCEPTION)
+            {
+                asIScriptFunction* function = context->GetExceptionFunction();
+                URHO3D_LOGERROR("Exception '" + String(context->GetExceptionString()) + "' in '" +
+                    String(function ? function->GetDeclaration() : subscriber.method_->GetDeclaration()) + "'");
+            }
+        }
+
+        context->Unprepare();
+        script->DecScriptNestingLevel();
+
+        subscriber.object_->Release();
+    }
+}
+
+void GameEventChannel::ReleaseScriptSubscriber(ScriptSubscriber &subscriber)
+{
+    if(subscriber.object_)
+    {
+        subscriber.weakRefFlag_->Release();
+        subscriber.object_ = nullptr;
+        subscriber.weakRefFlag_ = nullptr;
+    }
+}
+
+void GameEventChannel::PruneSubscribers(Queue &queue)
+{
+    for(unsigned i = 0; i < queue.handlers_.Size();)
+    {
+        if(!queue.handlers_[i] || !queue.handlers_[i]->GetReceiver())
+            queue.handlers_.Erase(i);
+        else
+            ++i;
+    }
+
+    for(unsigned i = 0; i < queue.scriptSubscribers_.Size();)
+    {
+        ScriptSubscriber& subscriber = queue.scriptSubscribers_[i];
+        if(subscriber.object_ && subscriber.weakRefFlag_->Get())
+        {
+            ReleaseScriptSubscriber(subscriber);
+        }
+
+        if(!subscriber.object_)
+            queue.scriptSubscribers_.Erase(i);
+        else
+            ++i;
+    }
+}
+
+void GameEventChannel::HandleUpdate(StringHash eventType, VariantMap &eventData)
+{
+    Flush();
+}
+
+void GameEventChannel::HandlePostUpdate(StringHash eventType, VariantMap &eventData)
+{
+    Flush();
+}
@@ -0,0 +1,163 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef GAMEEVENTCHANNEL_H
+#define GAMEEVENTCHANNEL_H
+
+#include <type_traits>
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Core/Object.h>
+
+#include "EventsAndDefs.h"
+
+class asIScriptObject;
+class asIScriptFunction;
+class asILockableSharedBool;
+
+using namespace Urho3D;
+
+/// Receives the events of one type that were queued since the last delivery, in posting order.
+class GameEventHandler : public RefCounted
+{
+public:
+    GameEventHandler(Object* receiver) : receiver_(receiver) {}
+
+    virtual void Invoke(const void* events, unsigned count) = 0;
+
+    /// Return the receiver, null once it has been destroyed.
+    Object* GetReceiver() const { return receiver_; }
+
+protected:
+    WeakPtr<Object> receiver_;
+};
+
+/// Typed game event handler calling a member function of the receiver.
+template <class T, class U> class GameEventHandlerImpl : public GameEventHandler
+{
+public:
+    typedef void (U::*HandlerFunctionPtr)(const T* events, unsigned count);
+
+    GameEventHandlerImpl(U* receiver, HandlerFunctionPtr function) : GameEventHandler(receiver), function_(function) {}
+
+    void Invoke(const void* events, unsigned count) override
+    {
+        (static_cast<U*>(receiver_.Get())->*function_)(static_cast<const T*>(events), count);
+    }
+
+private:
+    HandlerFunctionPtr function_;
+};
+
+/// Queues the gameplay events declared in EventsAndDefs.h as plain data and delivers them in batches per event
+/// type to C++ and script subscribers, at the start of the update and again after the scene update. The queues
+/// keep their memory between frames, so posting and delivering does not allocate once they have grown.
+class GameEventChannel : public Object
+{
+    URHO3D_OBJECT(GameEventChannel, Object)
+
+public:
+    GameEventChannel(Context* context);
+    ~GameEventChannel() override;
+
+    /// Queue an event. The payload type selects the event.
+    template <class T> void Post(const T& event)
+    {
+        static_assert(T::ID >= 0 && T::ID < GE_COUNT, "Game event payload has no valid event ID");
+        static_assert(std::is_standard_layout<T>::value && std::is_trivially_destructible<T>::value,
+            "Game event payloads must be plain data");
+        PostData(T::ID, &event, sizeof(T));
+    }
+
+    /// Subscribe a member function to the event of the payload type.
+    template <class T, class U> void Subscribe(U* receiver, void (U::*function)(const T* events, unsigned count))
+    {
+        static_assert(std::is_base_of<Object, U>::value, "Game event receivers must be Objects");
+        AddHandler(T::ID, new GameEventHandlerImpl<T, U>(receiver, function));
+    }
+
+    /// Unsubscribe the receiver from all events.
+    void Unsubscribe(Object* receiver);
+
+    /// Queue an event without payload by ID. Return false if the event has a payload.
+    bool Post(GameEventId id);
+    /// Subscribe a script object method to an event. The method takes the payload as const reference, or
+    /// nothing if the event has no payload. Return true if the method was found.
+    bool SubscribeScript(GameEventId id, asIScriptObject* object, const String& handlerName);
+    /// Unsubscribe a script object from an event.
+    void UnsubscribeScript(GameEventId id, asIScriptObject* object);
+    /// Unsubscribe a script object from all events.
+    void UnsubscribeScript(asIScriptObject* object);
+
+    /// Deliver all queued events, including the ones posted by the handlers in the meantime.
+    void Flush();
+
+    /// Return number of queued events.
+    unsigned GetPendingCount() const;
+
+private:
+    struct ScriptSubscriber
+    {
+        asIScriptObject* object_;
+        /// Set by AngelScript when the object is destroyed.
+        asILockableSharedBool* weakRefFlag_;
+        asIScriptFunction* method_;
+    };
+
+    /// Queue and subscribers of one event type.
+    struct Queue
+    {
+        Queue() : payloadSize_(0), hasPayload_(false) {}
+
+        unsigned payloadSize_;
+        bool hasPayload_;
+        /// Script parameter declaration of the handler methods.
+        String scriptParameter_;
+        /// Events posted since the last delivery.
+        PODVector<unsigned char> pending_;
+        /// Events being delivered, swapped with the pending buffer so that handlers can post safely.
+        PODVector<unsigned char> delivering_;
+        Vector<SharedPtr<GameEventHandler> > handlers_;
+        PODVector<ScriptSubscriber> scriptSubscribers_;
+    };
+
+    /// Set up the queue of an event type. Script type name is empty if the event has no payload.
+    template <class T> void RegisterEvent(const char* scriptTypeName);
+
+    void PostData(GameEventId id, const void* data, unsigned size);
+    void AddHandler(GameEventId id, GameEventHandler* handler);
+    void Deliver(Queue& queue);
+    void DeliverToScript(Queue& queue, unsigned count);
+    /// Release the script object of a subscriber, which is removed on the next prune.
+    void ReleaseScriptSubscriber(ScriptSubscriber& subscriber);
+    /// Remove unsubscribed and destroyed subscribers.
+    void PruneSubscribers(Queue& queue);
+
+    void HandleUpdate(StringHash eventType, VariantMap& eventData);
+    void HandlePostUpdate(StringHash eventType, VariantMap& eventData);
+
+    Queue queues_[GE_COUNT];
+    /// Whether events are being delivered, during which subscribers are only marked for removal.
+    bool flushing_;
+};
+
+#endif // GAMEEVENTCHANNEL_H
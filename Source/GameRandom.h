@@ -0,0 +1,56 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+#ifndef GAMERANDOM_H
+#define GAMERANDOM_H
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Core/Object.h>
+
+using namespace Urho3D;
+
+/// Random number generator of the gameplay simulation. It is kept apart from the engine's global generator, which
+/// the particle emitters also draw from while they are visible, so that spawns only depend on the seed and on the
+/// simulation itself and a replay takes the same course whether it is rendered or headless.
+class GameRandom : public Object
+{
+    URHO3D_OBJECT(GameRandom, Object)
+
+public:
+    GameRandom(Context* context);
+
+    /// Set the seed, which is also the state of the generator.
+    void SetSeed(unsigned seed) { seed_ = seed; }
+    /// Return the state of the generator.
+    unsigned GetSeed() const { return seed_; }
+
+    /// Return a random integer between 0 and 32767.
+    int Rand();
+    /// Return a random float between 0.0 (inclusive) and 1.0 (exclusive).
+    float Random() { return Rand() / 32768.0f; }
+    /// Return a random float between 0.0 (inclusive) and range (exclusive).
+    float Random(float range) { return Rand() * range / 32768.0f; }
+
+private:
+    unsigned seed_;
+};
+
+#endif // GAMERANDOM_H
@@ -0,0 +1,429 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Core/CoreEvents.h>
+#include <Urho3D/Core/ProcessUtils.h>
+#include <Urho3D/Engine/Engine.h>
+#include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/Resource/JSONFile.h>
+
+#include "BenchmarkRunner.h"
+#include "GameEventChannel.h"
+#include "GameRandom.h"
+#include "LevelManager.h"
+#include "PlayerInput.h"
+#include "ResourcePreloader.h"
+#include "InputRecorder.h"
+
+static const char* RECORDING_FILE_ID = "DREC";
+static const unsigned RECORDING_VERSION = 1;
+//Frames between the random number generator states stored to detect a diverging replay
+static const unsigned CHECKSUM_INTERVAL = 60;
+//Event type of the level input events, after the transitions
+static const unsigned char RECORDED_LEVEL_EVENT = 0xff;
+
+//Contents of a recorded frame besides its timestep
+enum RecordedFrameFlags
+{
+    RF_LOOK = 0x1,
+    RF_FIRE = 0x2,
+    RF_EVENTS = 0x4,
+    RF_CHECKSUM = 0x8
+};
+
+/// Map a signed value to an unsigned one that is small when the value is near zero.
+static unsigned EncodeSigned(int value)
+{
+    return ((unsigned)value << 1u) ^ (unsigned)(value >> 31);
+}
+
+static int DecodeSigned(unsigned value)
+{
+    return (int)(value >> 1u) ^ -(int)(value & 1u);
+}
+
+InputRecorder::InputRecorder(Context *context) : Object(context)
+, seed_(0)
+, numJoysticks_(0)
+, started_(false)
+, frameTimeStep_(0.0f)
+, lookDelta_(IntVector2::ZERO)
+, firePressed_(false)
+, hasChecksum_(false)
+, checksum_(0)
+, frameNumber_(0)
+, elapsedTime_(0.0f)
+, divergedFrame_(-1)
+{
+}
+
+bool InputRecorder::StartRecording(const String &fileName, unsigned seed)
+{
+    SharedPtr<File> file(new File(context_, fileName, FILE_WRITE));
+    if(!file->IsOpen())
+        return false;
+
+    seed_ = seed;
+    numJoysticks_ = GetSubsystem<PlayerInput>()->GetNumJoysticks();
+
+    file->WriteFileID(RECORDING_FILE_ID);
+    file->WriteUInt(RECORDING_VERSION);
+    file->WriteUInt(seed_);
+    file->WriteVLE(numJoysticks_);
+
+    recordFile_ = file;
+    started_ = false;
+
+    SubscribeToEvent(E_BEGINFRAME, URHO3D_HANDLER(InputRecorder, HandleBeginFrame));
+    SubscribeToEvent(E_ENDFRAME, URHO3D_HANDLER(InputRecorder, HandleEndFrame));
+
+    URHO3D_LOGINFO("Recording input to " + fileName);
+    return true;
+}
+
+bool InputRecorder::LoadReplay(const String &fileName)
+{
+    SharedPtr<File> file(new File(context_, fileName, FILE_READ));
+    if(!file->IsOpen())
+        return false;
+
+    if(file->ReadFileID() != RECORDING_FILE_ID || file->ReadUInt() != RECORDING_VERSION)
+    {
+        URHO3D_LOGERROR(fileName + " is not an input recording of this version");
+        return false;
+    }
+
+    seed_ = file->ReadUInt();
+    numJoysticks_ = file->ReadVLE();
+
+    //the level sets up the controllers it saw during the recording, whatever is connected now
+    GetSubsystem<PlayerInput>()->SetNumJoysticks(numJoysticks_);
+
+    replayFile_ = file;
+    return true;
+}
+
+void InputRecorder::Replay(LevelManager *levelManager)
+{
+    if(!replayFile_)
+        return;
+
+    levelManager_ = levelManager;
+    started_ = false;
+
+    //frames are neither limited nor paused, every frame advances the level by the recorded timestep
+    auto* engine = GetSubsystem<Engine>();
+    engine->SetMaxFps(0);
+    engine->SetMaxInactiveFps(0);
+    engine->SetPauseMinimized(false);
+
+    SubscribeToEvent(E_BEGINFRAME, URHO3D_HANDLER(InputRecorder, HandleBeginFrame));
+    SubscribeToEvent(E_POSTUPDATE, URHO3D_HANDLER(InputRecorder, HandlePostUpdate));
+    SubscribeToEvent(E_ENDFRAME, URHO3D_HANDLER(InputRecorder, HandleEndFrame));
+
+    URHO3D_LOGINFO("Replaying " + replayFile_->GetName() + " with seed " + String(seed_));
+}
+
+void InputRecorder::Stop()
+{
+    if(recordFile_)
+    {
+        URHO3D_LOGINFO("Recorded " + String(frameNumber_) + " frames to " + recordFile_->GetName());
+        recordFile_->Close();
+        recordFile_.Reset();
+    }
+
+    if(replayFile_)
+    {
+        WriteReport();
+        replayFile_->Close();
+        replayFile_.Reset();
+    }
+
+    UnsubscribeFromAllEvents();
+}
+
+void InputRecorder::RecordLook(int dx, int dy)
+{
+    if(!started_ || !recordFile_)
+        return;
+
+    lookDelta_.x_ += dx;
+    lookDelta_.y_ += dy;
+}
+
+void InputRecorder::RecordFire()
+{
+    if(!started_ || !recordFile_)
+        return;
+
+    firePressed_ = true;
+}
+
+void InputRecorder::RecordLevelEvent(int eventId, const VariantMap &eventData)
+{
+    if(!started_ || !recordFile_)
+        return;
+
+    RecordedEvent event;
+    event.type_ = RECORDED_LEVEL_EVENT;
+    event.eventId_ = (unsigned char)eventId;
+    event.eventData_ = eventData;
+    events_.Push(event);
+}
+
+void InputRecorder::RecordTransition(RecordedTransition transition)
+{
+    if(!recordFile_)
+        return;
+
+    //the level is empty until it is first entered, from there on everything it does follows from the seed,
+    //the timesteps and the input
+    if(!started_)
+    {
+        if(transition != RT_STARTLEVEL)
+            return;
+
+        GetSubsystem<GameRandom>()->SetSeed(seed_);
+        started_ = true;
+    }
+
+    RecordedEvent event;
+    event.type_ = (unsigned char)transition;
+    event.eventId_ = 0;
+    events_.Push(event);
+}
+
+void InputRecorder::HandleBeginFrame(StringHash eventType, VariantMap &eventData)
+{
+    if(recordFile_)
+    {
+        //the level may be entered during this frame, so the timestep is kept before the recording starts
+        frameTimeStep_ = eventData[BeginFrame::P_TIMESTEP].GetFloat();
+        return;
+    }
+
+    if(!started_ || !levelManager_)
+        return;
+
+    //the input arrives where the input events would, before the update
+    frameTimer_.Reset();
+
+    auto* playerInput = GetSubsystem<PlayerInput>();
+    if(lookDelta_ != IntVector2::ZERO)
+        playerInput->AddLookDelta(lookDelta_.x_, lookDelta_.y_);
+    if(firePressed_)
+        playerInput->PressFire();
+
+    for(unsigned i = 0; i < events_.Size(); ++i)
+    {
+        RecordedEvent& event = events_[i];
+
+        if(event.type_ == RECORDED_LEVEL_EVENT)
+        {
+            levelManager_->HandleLevelEvent(event.eventId_, event.eventData_);
+        }
+        else if(event.type_ == RT_STARTLEVEL)
+        {
+            if(frameNumber_ == 0)
+                GetSubsystem<GameRandom>()->SetSeed(seed_);
+
+            levelManager_->StartOrResumeLevel();
+        }
+        else if(event.type_ == RT_DEACTIVATE)
+        {
+            levelManager_->Deactivate();
+        }
+    }
+}
+
+void InputRecorder::HandlePostUpdate(StringHash eventType, VariantMap &eventData)
+{
+    if(!started_)
+        return;
+
+    //the countdown ends with the UI update, which does not run headless
+    for(unsigned i = 0; i < events_.Size(); ++i)
+    {
+        if(events_[i].type_ == RT_COUNTFINISHED)
+        {
+            GetSubsystem<GameEventChannel>()->Post(CountFinished::Data());
+        }
+    }
+}
+
+void InputRecorder::HandleEndFrame(StringHash eventType, VariantMap &eventData)
+{
+    if(recordFile_)
+    {
+        if(started_)
+            WriteFrame();
+        return;
+    }
+
+    if(!started_)
+    {
+        //the replay waits until the level is loaded, the frames before it are not part of the recording
+        if(!GetSubsystem<ResourcePreloader>()->IsComplete())
+            return;
+
+        started_ = true;
+    }
+    else
+    {
+        frameTimes_.Push(frameTimer_.GetUSec(false) / 1000.0f);
+        elapsedTime_ += frameTimeStep_;
+
+        if(hasChecksum_ && checksum_ != GetSubsystem<GameRandom>()->GetSeed() && divergedFrame_ < 0)
+        {
+            divergedFrame_ = frameNumber_;
+            URHO3D_LOGERROR("Replay diverged from the recording at frame " + String(frameNumber_));
+        }
+
+        ++frameNumber_;
+    }
+
+    if(!ReadFrame())
+    {
+        GetSubsystem<Engine>()->Exit();
+    }
+}
+
+void InputRecorder::WriteFrame()
+{
+    unsigned char flags = 0;
+    if(lookDelta_ != IntVector2::ZERO)
+        flags |= RF_LOOK;
+    if(firePressed_)
+        flags |= RF_FIRE;
+    if(!events_.Empty())
+        flags |= RF_EVENTS;
+    if(frameNumber_ % CHECKSUM_INTERVAL == 0)
+        flags |= RF_CHECKSUM;
+
+    recordFile_->WriteFloat(frameTimeStep_);
+    recordFile_->WriteUByte(flags);
+
+    if(flags & RF_LOOK)
+    {
+        recordFile_->WriteVLE(EncodeSigned(lookDelta_.x_));
+        recordFile_->WriteVLE(EncodeSigned(lookDelta_.y_));
+    }
+
+    if(flags & RF_EVENTS)
+    {
+        recordFile_->WriteVLE(events_.Size());
+        for(unsigned i = 0; i < events_.Size(); ++i)
+        {
+            const RecordedEvent& event = events_[i];
+            recordFile_->WriteUByte(event.type_);
+
+            if(event.type_ == RECORDED_LEVEL_EVENT)
+            {
+                recordFile_->WriteUByte(event.eventId_);
+                recordFile_->WriteVariantMap(event.eventData_);
+            }
+        }
+    }
+
+    if(flags & RF_CHECKSUM)
+        recordFile_->WriteUInt(GetSubsystem<GameRandom>()->GetSeed());
+
+    lookDelta_ = IntVector2::ZERO;
+    firePressed_ = false;
+    events_.Clear();
+    ++frameNumber_;
+}
+
+bool InputRecorder::ReadFrame()
+{
+    events_.Clear();
+
+    if(replayFile_->IsEof())
+        return false;
+
+    frameTimeStep_ = replayFile_->ReadFloat();
+    unsigned char flags = replayFile_->ReadUByte();
+
+    lookDelta_ = IntVector2::ZERO;
+    if(flags & RF_LOOK)
+    {
+        lookDelta_.x_ = DecodeSigned(replayFile_->ReadVLE());
+        lookDelta_.y_ = DecodeSigned(replayFile_->ReadVLE());
+    }
+
+    firePressed_ = (flags & RF_FIRE) != 0;
+
+    if(flags & RF_EVENTS)
+    {
+        events_.Resize(replayFile_->ReadVLE());
+        for(unsigned i = 0; i < events_.Size(); ++i)
+        {
+            RecordedEvent& event = events_[i];
+            event.type_ = replayFile_->ReadUByte();
+            event.eventId_ = 0;
+
+            if(event.type_ == RECORDED_LEVEL_EVENT)
+            {
+                event.eventId_ = replayFile_->ReadUByte();
+                event.eventData_ = replayFile_->ReadVariantMap();
+            }
+        }
+    }
+
+    hasChecksum_ = (flags & RF_CHECKSUM) != 0;
+    checksum_ = hasChecksum_ ? replayFile_->ReadUInt() : 0;
+
+    GetSubsystem<Engine>()->SetNextTimeStep(frameTimeStep_);
+    return true;
+}
+
+void InputRecorder::WriteReport()
+{
+    String replayName = GetFileName(replayFile_->GetName());
+
+    JSONFile report(context_);
+    JSONValue& root = report.GetRoot();
+    root.Set("replay", replayName);
+    root.Set("seed", seed_);
+    root.Set("frames", frameNumber_);
+    root.Set("simulatedTime", elapsedTime_);
+    root.Set("frameTimeMs", BenchmarkRunner::GetTimingSummary(frameTimes_));
+    root.Set("divergedFrame", divergedFrame_);
+
+    auto* fileSystem = GetSubsystem<FileSystem>();
+    String dirName = fileSystem->GetCurrentDir() + "AppLog";
+    if(!fileSystem->DirExists(dirName))
+    {
+        fileSystem->CreateDir(dirName);
+    }
+
+    String fileName = dirName + "/Replay_" + replayName + ".json";
+    if(report.SaveFile(fileName))
+    {
+        URHO3D_LOGINFO("Replay report written to " + fileName);
+    }
+
+    PrintLine(report.ToString("  "));
+}
@@ -0,0 +1,129 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef INPUTRECORDER_H
+#define INPUTRECORDER_H
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Core/Object.h>
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/IO/File.h>
+#include <Urho3D/Math/Vector2.h>
+
+using namespace Urho3D;
+
+class LevelManager;
+
+/// Level state transitions that are recorded along with the input.
+enum RecordedTransition
+{
+    RT_STARTLEVEL = 0,
+    RT_DEACTIVATE,
+    RT_COUNTFINISHED
+};
+
+/// Records the input of a played session to a binary file and replays it. A recording starts when the level is
+/// first entered and holds the random seed, then per frame the timestep, the summed look delta, the fire press,
+/// the level input events and the level state transitions. Frames without input take five bytes. Replaying
+/// feeds the frames back at the same points of the frame with the recorded timesteps, so the level simulates
+/// the same steps as in the recorded session, headless or rendered, and reports the frame times when it ends.
+class InputRecorder : public Object
+{
+    URHO3D_OBJECT(InputRecorder, Object)
+
+public:
+    InputRecorder(Context* context);
+
+    /// Start recording to a file. The random seed is applied when the level is entered. Return true if successful.
+    bool StartRecording(const String& fileName, unsigned seed);
+    /// Load a recording for replay. Return true if successful.
+    bool LoadReplay(const String& fileName);
+    /// Replay the loaded recording on the level once its resources are loaded, then exit the engine.
+    void Replay(LevelManager* levelManager);
+    /// Finish the recording, or write the report of the replay.
+    void Stop();
+
+    /// Record a summed look delta.
+    void RecordLook(int dx, int dy);
+    /// Record a fire press.
+    void RecordFire();
+    /// Record a level input event.
+    void RecordLevelEvent(int eventId, const VariantMap& eventData);
+    /// Record a level state transition. The first level start starts the recording.
+    void RecordTransition(RecordedTransition transition);
+
+    /// Return whether a session is being recorded.
+    bool IsRecording() const { return recordFile_ != nullptr; }
+    /// Return whether a recording is being replayed.
+    bool IsReplaying() const { return replayFile_ != nullptr; }
+    /// Return random seed of the recording.
+    unsigned GetSeed() const { return seed_; }
+
+private:
+    /// Recorded level input event or transition.
+    struct RecordedEvent
+    {
+        /// Transition, or RECORDED_LEVEL_EVENT for a level input event.
+        unsigned char type_;
+        unsigned char eventId_;
+        VariantMap eventData_;
+    };
+
+    void HandleBeginFrame(StringHash eventType, VariantMap& eventData);
+    void HandlePostUpdate(StringHash eventType, VariantMap& eventData);
+    void HandleEndFrame(StringHash eventType, VariantMap& eventData);
+
+    /// Write the frame recorded so far and clear it.
+    void WriteFrame();
+    /// Read the next frame to replay and set it as the timestep of the next engine frame. Return false at the end.
+    bool ReadFrame();
+    /// Write the replay report to the log directory and standard output.
+    void WriteReport();
+
+    SharedPtr<File> recordFile_;
+    SharedPtr<File> replayFile_;
+    WeakPtr<LevelManager> levelManager_;
+    unsigned seed_;
+    /// Number of joysticks during the recording.
+    unsigned numJoysticks_;
+    /// Whether the level has been entered and frames are being recorded or replayed.
+    bool started_;
+
+    /// Input of the frame being recorded or replayed.
+    float frameTimeStep_;
+    IntVector2 lookDelta_;
+    bool firePressed_;
+    Vector<RecordedEvent> events_;
+    /// Gameplay random number generator state after the frame, stored every few frames to detect divergence.
+    bool hasChecksum_;
+    unsigned checksum_;
+    unsigned frameNumber_;
+
+    HiresTimer frameTimer_;
+    /// Replayed frame times in milliseconds.
+    PODVector<float> frameTimes_;
+    float elapsedTime_;
+    /// First replayed frame that diverged from the recording, or negative.
+    int divergedFrame_;
+};
+
+#endif // INPUTRECORDER_H
@@ -21,12 +21,38 @@
 //
 
 #include <Urho3D/Scene/Node.h>
+#include <Urho3D/AngelScript/Script.h>
 #include <Urho3D/AngelScript/ScriptFile.h>
 #include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/Resource/ResourceEvents.h>
 
+#include <AngelScript/angelscript.h>
+
+#include "PerfCounters.h"
 #include "LevelManager.h"
 
+//Script method declarations for each level event, indexed by event ID
+static const char* levelEventDeclarations[EVT_COUNT] =
+{
+    nullptr,
+    "void HandleUpdate(VariantMap&)",               //EVT_UPDATE
+    "void HandleKeyDown(VariantMap&)",              //EVT_KEYDOWN
+    nullptr,                                        //EVT_MOUSECLICK (polled in HandleUpdate)
+    nullptr,                                        //EVT_MOUSEMOVE (summed up by PlayerInput)
+    "void HandleSoundFinish(VariantMap&)",          //EVT_SOUNDFINISH
+    "void HandleJoystickButtonDown(VariantMap&)",   //EVT_JOYSTICK_BUTTONDOWN
+    "void HandleJoystickButtonUp(VariantMap&)",     //EVT_JOYSTICK_BUTTONUP
+    "void HandleHatMove(VariantMap&)",              //EVT_JOYSTICK_HATMOVE
+    "void HandleWebWindowResized(VariantMap&)"      //EVT_WEB_WINDOW_RESIZED
+};
+
 LevelManager::LevelManager(Context *context): LogicComponent(context), hasScriptObject(false)
+, initialiseMethod_(nullptr)
+, activateMethod_(nullptr)
+, deactivateMethod_(nullptr)
+, startOrResumeMethod_(nullptr)
+, startBenchmarkMethod_(nullptr)
+, eventMethods_()
 {
 
 }
@@ -36,9 +62,19 @@ void LevelManager::Initialise()
     instance_ = GetNode()->CreateComponent<ScriptInstance>();
 
     ResourceCache* cache = GetSubsystem<ResourceCache>();
-    instance_->CreateObject(cache->GetResource<ScriptFile>("Scripts/LevelManager.as"),"LevelOneManager");
-    instance_->Execute("void Initialise()");
-    hasScriptObject = true;
+    auto* scriptFile = cache->GetResource<ScriptFile>("Scripts/LevelManager.as");
+    instance_->CreateObject(scriptFile,"LevelOneManager");
+
+    hasScriptObject = instance_->GetScriptObject() != nullptr;
+    if(!hasScriptObject)
+        return;
+
+    ResolveScriptMethods();
+
+    //the script instance recreates its object on reload, so the handles have to be resolved again
+    SubscribeToEvent(scriptFile, E_RELOADFINISHED, URHO3D_HANDLER(LevelManager, HandleScriptReloaded));
+
+    ExecuteScriptMethod(initialiseMethod_);
 }
 
 void LevelManager::InitialiseAndActivate()
@@ -52,7 +88,7 @@ void LevelManager::Activate()
     if(!hasScriptObject)
         return;
 
-    instance_->Execute("void Activate()");
+    ExecuteScriptMethod(activateMethod_);
 }
 
 void LevelManager::Deactivate()
@@ -60,17 +96,16 @@ void LevelManager::Deactivate()
     if(!hasScriptObject)
         return;
 
-    instance_->Execute("void Deactivate()");
+    ExecuteScriptMethod(deactivateMethod_);
 }
 
-void LevelManager::HandleLevelEvent(VariantMap &eventData)
+void LevelManager::HandleLevelEvent(int eventId, VariantMap &eventData)
 {
-    if(!hasScriptObject)
+    if(!hasScriptObject || eventId <= 0 || eventId >= EVT_COUNT)
         return;
 
-    VariantVector parameters;
-    parameters.Push(eventData);
-    instance_->Execute("void HandleLevelEvent(VariantMap& eventData)",parameters);
+    PerfScope scope(GetSubsystem<PerfCounters>(), "LevelManager::HandleLevelEvent");
+    ExecuteScriptMethod(eventMethods_[eventId], &eventData);
 }
 
 void LevelManager::StartOrResumeLevel()
@@ -78,5 +113,78 @@ void LevelManager::StartOrResumeLevel()
     if(!hasScriptObject)
         return;
 
-    instance_->Execute("void StartOrResumeLevel()");
+    ExecuteScriptMethod(startOrResumeMethod_);
+}
+
+void LevelManager::StartBenchmark(VariantMap &settings)
+{
+    if(!hasScriptObject)
+        return;
+
+    ExecuteScriptMethod(startBenchmarkMethod_, &settings);
+}
+
+void LevelManager::ResolveScriptMethods()
+{
+    initialiseMethod_ = GetScriptMethod("void Initialise()");
+    activateMethod_ = GetScriptMethod("void Activate()");
+    deactivateMethod_ = GetScriptMethod("void Deactivate()");
+    startOrResumeMethod_ = GetScriptMethod("void StartOrResumeLevel()");
+    startBenchmarkMethod_ = GetScriptMethod("void StartBenchmark(VariantMap&)");
+
+    for(int i = 0; i < EVT_COUNT; ++i)
+    {
+        eventMethods_[i] = levelEventDeclarations[i] ? GetScriptMethod(levelEventDeclarations[i]) : nullptr;
+    }
+}
+
+asIScriptFunction* LevelManager::GetScriptMethod(const char* declaration) const
+{
+    asIScriptObject* object = instance_->GetScriptObject();
+    ScriptFile* scriptFile = instance_->GetScriptFile();
+
+    if(!object || !scriptFile)
+        return nullptr;
+
+    return scriptFile->GetMethod(object, declaration);
+}
+
+bool LevelManager::ExecuteScriptMethod(asIScriptFunction* method, VariantMap* eventData)
+{
+    asIScriptObject* object = instance_ ? instance_->GetScriptObject() : nullptr;
+
+    if(!method || !object)
+        return false;
+
+    //Calls the method on the context of the current nesting level directly, rather than through
+    //ScriptInstance::Execute, so the event data is handed over by reference instead of copied into a VariantVector
+    auto* script = GetSubsystem<Script>();
+    asIScriptContext* context = script->GetScriptFileContext();
+
+    if(context->Prepare(method) < 0)
+        return false;
+
+    context->SetObject(object);
+
+    if(eventData)
+    {
+        context->SetArgObject(0, eventData);
+    }
+
+    script->IncScriptNestingLevel();
+    bool success = context->Execute() >= 0;
+    context->Unprepare();
+    script->DecScriptNestingLevel();
+
+    return success;
+}
+
+void LevelManager::HandleScriptReloaded(StringHash eventType, VariantMap &eventData)
+{
+    hasScriptObject = instance_ && instance_->GetScriptObject() != nullptr;
+
+    if(hasScriptObject)
+    {
+        ResolveScriptMethods();
+    }
 }
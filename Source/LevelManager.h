@@ -27,6 +27,10 @@
 #include <Urho3D/Scene/LogicComponent.h>
 #include <Urho3D/AngelScript/ScriptInstance.h>
 
+#include "EventsAndDefs.h"
+
+class asIScriptFunction;
+
 using namespace Urho3D;
 
 class LevelManager : public LogicComponent
@@ -39,12 +43,31 @@ public:
         void InitialiseAndActivate();
         void Activate();
         void Deactivate();
-        void HandleLevelEvent(VariantMap& eventData);
+        void HandleLevelEvent(int eventId, VariantMap& eventData);
         void StartOrResumeLevel();
+        /// Start the level directly in game with the benchmark scenario settings.
+        void StartBenchmark(VariantMap& settings);
 
 private:
+        /// Resolve the level script methods to function handles.
+        void ResolveScriptMethods();
+        /// Return the script method matching the declaration or null if not found.
+        asIScriptFunction* GetScriptMethod(const char* declaration) const;
+        /// Call a resolved script method, passing the event data by reference when given.
+        bool ExecuteScriptMethod(asIScriptFunction* method, VariantMap* eventData = nullptr);
+        /// Handle the level script being reloaded, which invalidates the resolved methods.
+        void HandleScriptReloaded(StringHash eventType, VariantMap& eventData);
+
         bool hasScriptObject;
         WeakPtr<ScriptInstance> instance_;
+
+        asIScriptFunction* initialiseMethod_;
+        asIScriptFunction* activateMethod_;
+        asIScriptFunction* deactivateMethod_;
+        asIScriptFunction* startOrResumeMethod_;
+        asIScriptFunction* startBenchmarkMethod_;
+        /// Event handler methods indexed by level event ID.
+        asIScriptFunction* eventMethods_[EVT_COUNT];
 };
 
 #endif // LEVELMANAGER_H
@@ -0,0 +1,333 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/Scene/Scene.h>
+#include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/Resource/XMLFile.h>
+#include <Urho3D/Physics/CollisionShape.h>
+#include <Urho3D/Physics/PhysicsWorld.h>
+#include <Urho3D/Physics/RigidBody.h>
+#include <Urho3D/Scene/SceneEvents.h>
+#include <Urho3D/AngelScript/ScriptFile.h>
+#include <Urho3D/AngelScript/ScriptInstance.h>
+
+#include <Bullet/BulletDynamics/Dynamics/btDiscreteDynamicsWorld.h>
+
+#include "PrefabCache.h"
+#include "NodePool.h"
+
+//Where parked bodies wait, away from the play field so they stay out of its broadphase cells
+static const Vector3 PARK_POSITION(0.0f, -1000.0f, 0.0f);
+
+NodePool::NodePool(Context *context) : Component(context)
+{
+
+}
+
+void NodePool::RegisterObject(Context *context)
+{
+    context->RegisterFactory<NodePool>();
+}
+
+bool NodePool::LoadDefinitions(const String &fileName)
+{
+    auto* cache = GetSubsystem<ResourceCache>();
+    XMLFile* file = cache->GetResource<XMLFile>(fileName);
+
+    if(!file)
+        return false;
+
+    for(XMLElement poolElem = file->GetRoot().GetChild("pool"); poolElem; poolElem = poolElem.GetNext("pool"))
+    {
+        DefinePool(poolElem.GetAttribute("name"), poolElem.GetAttribute("object"), poolElem.GetAttribute("script"),
+            poolElem.GetAttribute("class"), poolElem.GetUInt("prewarm"));
+    }
+
+    return true;
+}
+
+void NodePool::DefinePool(const String &name, const String &objectFile, const String &scriptFile, const String &className, unsigned prewarmCount)
+{
+    if(name.Empty() || (objectFile.Empty() && (scriptFile.Empty() || className.Empty())))
+    {
+        URHO3D_LOGERROR("Invalid node pool definition " + name);
+        return;
+    }
+
+    StringHash poolName(name);
+    Pool& pool = pools_[poolName];
+    pool.objectFile_ = objectFile;
+    pool.scriptFile_ = scriptFile;
+    pool.className_ = className;
+
+    while(pool.size_ < prewarmCount)
+    {
+        if(!CreatePooledNode(pool, poolName))
+            break;
+    }
+}
+
+Node* NodePool::Acquire(const String &name, const Vector3 &position, const Quaternion &rotation)
+{
+    StringHash poolName(name);
+    auto it = pools_.Find(poolName);
+
+    if(it == pools_.End())
+    {
+        URHO3D_LOGERROR("Unknown node pool " + name);
+        return nullptr;
+    }
+
+    Pool& pool = it->second_;
+    Node* node = nullptr;
+
+    //skip nodes that were removed from the scene behind the pool's back
+    while(!node && !pool.freeNodes_.Empty())
+    {
+        node = pool.freeNodes_.Back();
+        pool.freeNodes_.Pop();
+    }
+
+    if(!node)
+    {
+        node = CreatePooledNode(pool, poolName);
+        if(!node)
+            return nullptr;
+
+        pool.freeNodes_.Pop();
+    }
+
+    pooledNodes_[node->GetID()].free_ = false;
+
+    node->SetWorldTransform(position, rotation);
+    SetNodeActive(node, true);
+    ResetPhysics(node);
+
+    //let the script object reinitialise itself for the new use
+    ExecuteScriptHook(node, "void OnAcquired()");
+
+    return node;
+}
+
+bool NodePool::Release(Node *node)
+{
+    if(!node)
+        return false;
+
+    auto it = pooledNodes_.Find(node->GetID());
+    if(it == pooledNodes_.End())
+        return false;
+
+    //releasing twice, e.g. on two contacts in the same step, is harmless
+    if(it->second_.free_)
+        return true;
+
+    it->second_.free_ = true;
+    ExecuteScriptHook(node, "void OnReleased()");
+    SetNodeActive(node, false);
+    pools_[it->second_.pool_].freeNodes_.Push(WeakPtr<Node>(node));
+
+    return true;
+}
+
+bool NodePool::IsPooled(Node *node) const
+{
+    return node && pooledNodes_.Contains(node->GetID());
+}
+
+unsigned NodePool::GetFreeCount(const String &name) const
+{
+    auto it = pools_.Find(StringHash(name));
+    return it != pools_.End() ? it->second_.freeNodes_.Size() : 0;
+}
+
+unsigned NodePool::GetPoolSize(const String &name) const
+{
+    auto it = pools_.Find(StringHash(name));
+    return it != pools_.End() ? it->second_.size_ : 0;
+}
+
+void NodePool::OnSceneSet(Scene *scene)
+{
+    if(scene)
+    {
+        if(!poolRoot_)
+            poolRoot_ = scene->CreateChild("NodePool", LOCAL);
+
+        SubscribeToEvent(scene, E_NODEREMOVED, URHO3D_HANDLER(NodePool, HandleNodeRemoved));
+    }
+    else
+    {
+        UnsubscribeFromEvent(E_NODEREMOVED);
+    }
+}
+
+void NodePool::HandleNodeRemoved(StringHash eventType, VariantMap &eventData)
+{
+    using namespace NodeRemoved;
+
+    //pooled nodes are children of the pool root, a node removed from it behind the pool's back leaves the pool
+    if(!poolRoot_ || eventData[P_PARENT].GetPtr() != poolRoot_.Get())
+        return;
+
+    auto* node = static_cast<Node*>(eventData[P_NODE].GetPtr());
+    auto it = pooledNodes_.Find(node->GetID());
+    if(it == pooledNodes_.End())
+        return;
+
+    auto poolIt = pools_.Find(it->second_.pool_);
+    if(poolIt != pools_.End())
+    {
+        Pool& pool = poolIt->second_;
+        --pool.size_;
+
+        if(it->second_.free_)
+            pool.freeNodes_.Remove(WeakPtr<Node>(node));
+    }
+
+    pooledNodes_.Erase(it);
+}
+
+Node* NodePool::CreatePooledNode(Pool &pool, StringHash poolName)
+{
+    if(!poolRoot_)
+        return nullptr;
+
+    Node* node = nullptr;
+
+    if(!pool.objectFile_.Empty())
+    {
+        node = GetSubsystem<PrefabCache>()->InstantiatePrefab(poolRoot_, pool.objectFile_, Vector3::ZERO, Quaternion::IDENTITY, LOCAL);
+        if(!node)
+            return nullptr;
+    }
+    else
+    {
+        auto* cache = GetSubsystem<ResourceCache>();
+        node = poolRoot_->CreateChild(String::EMPTY, LOCAL);
+
+        auto* instance = node->CreateComponent<ScriptInstance>();
+        if(!instance->CreateObject(cache->GetResource<ScriptFile>(pool.scriptFile_), pool.className_))
+        {
+            node->Remove();
+            return nullptr;
+        }
+    }
+
+    SetNodeActive(node, false);
+
+    PooledNode& pooledNode = pooledNodes_[node->GetID()];
+    pooledNode.pool_ = poolName;
+    pooledNode.free_ = true;
+
+    pool.freeNodes_.Push(WeakPtr<Node>(node));
+    ++pool.size_;
+
+    return node;
+}
+
+void NodePool::ExecuteScriptHook(Node *node, const String &declaration)
+{
+    auto* instance = node->GetComponent<ScriptInstance>();
+    if(!instance || !instance->GetScriptObject())
+        return;
+
+    //hooks are optional, so look the method up instead of letting ScriptInstance::Execute log an error
+    ScriptFile* scriptFile = instance->GetScriptFile();
+    asIScriptFunction* method = scriptFile->GetMethod(instance->GetScriptObject(), declaration);
+
+    if(method)
+    {
+        scriptFile->Execute(instance->GetScriptObject(), method);
+    }
+}
+
+void NodePool::SetNodeActive(Node *node, bool active)
+{
+    PODVector<Node*> nodes;
+    node->GetChildren(nodes, true);
+    nodes.Push(node);
+
+    for(unsigned i = 0; i < nodes.Size(); ++i)
+    {
+        const Vector<SharedPtr<Component> >& components = nodes[i]->GetComponents();
+        for(unsigned j = 0; j < components.Size(); ++j)
+        {
+            Component* component = components[j];
+
+            //the physics components stay enabled, toggling them would remove the body from the physics world and
+            //add it again on every reuse
+            if(component->GetType() == RigidBody::GetTypeStatic())
+                ParkBody(static_cast<RigidBody*>(component), !active);
+            else if(component->GetType() != CollisionShape::GetTypeStatic())
+                component->SetEnabled(active);
+        }
+    }
+}
+
+void NodePool::ParkBody(RigidBody *body, bool park)
+{
+    btRigidBody* btBody = body->GetBody();
+    PhysicsWorld* physicsWorld = body->GetPhysicsWorld();
+    if(!btBody || !physicsWorld || !btBody->getBroadphaseHandle())
+        return;
+
+    btBroadphaseProxy* proxy = btBody->getBroadphaseHandle();
+
+    if(park)
+    {
+        body->SetLinearVelocity(Vector3::ZERO);
+        body->SetAngularVelocity(Vector3::ZERO);
+        body->ResetForces();
+        body->GetNode()->SetWorldPosition(PARK_POSITION);
+
+        //the body stays in the world but passes no broadphase filter and is not simulated, so it neither moves nor
+        //collides. Its current contacts are dropped right away
+        proxy->m_collisionFilterGroup = 0;
+        proxy->m_collisionFilterMask = 0;
+        btDiscreteDynamicsWorld* world = physicsWorld->GetWorld();
+        world->getBroadphase()->getOverlappingPairCache()->cleanProxyFromPairs(proxy, world->getDispatcher());
+        btBody->forceActivationState(DISABLE_SIMULATION);
+    }
+    else
+    {
+        //same filter as the physics world gives the body when adding it
+        proxy->m_collisionFilterGroup = (int)body->GetCollisionLayer();
+        proxy->m_collisionFilterMask = (int)body->GetCollisionMask();
+        btBody->forceActivationState(ACTIVE_TAG);
+        body->Activate();
+    }
+}
+
+void NodePool::ResetPhysics(Node *node)
+{
+    auto* body = node->GetComponent<RigidBody>();
+    if(!body)
+        return;
+
+    body->SetTransform(node->GetWorldPosition(), node->GetWorldRotation());
+    body->SetLinearVelocity(Vector3::ZERO);
+    body->SetAngularVelocity(Vector3::ZERO);
+    body->ResetForces();
+}
@@ -0,0 +1,106 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef NODEPOOL_H
+#define NODEPOOL_H
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Scene/Component.h>
+#include <Urho3D/Scene/Node.h>
+#include <Urho3D/Container/HashMap.h>
+
+namespace Urho3D
+{
+    class RigidBody;
+}
+
+using namespace Urho3D;
+
+/// Keeps fully built scene nodes for recycling. Released nodes have their components disabled instead of being
+/// removed and re-enabled on acquire, so their components, physics bodies and script objects are only built once.
+/// Rigid bodies stay in the physics world, parked off the field where they neither move nor collide.
+class NodePool : public Component
+{
+    URHO3D_OBJECT(NodePool, Component)
+
+public:
+    NodePool(Context* context);
+
+    static void RegisterObject(Context* context);
+
+    /// Load pool definitions from an XML file and prewarm each pool.
+    bool LoadDefinitions(const String& fileName);
+    /// Define a pool and prewarm it. Nodes are built from the object file if given, otherwise from the script class.
+    void DefinePool(const String& name, const String& objectFile, const String& scriptFile, const String& className, unsigned prewarmCount);
+    /// Take a node from the pool, place it and enable it. The pool grows if it is exhausted.
+    Node* Acquire(const String& name, const Vector3& position, const Quaternion& rotation);
+    /// Return a node to its pool. Return false if the node does not belong to a pool.
+    bool Release(Node* node);
+    /// Return whether the node belongs to a pool.
+    bool IsPooled(Node* node) const;
+    /// Return number of nodes ready for use in a pool.
+    unsigned GetFreeCount(const String& name) const;
+    /// Return total number of nodes built for a pool.
+    unsigned GetPoolSize(const String& name) const;
+
+protected:
+    void OnSceneSet(Scene* scene) override;
+
+private:
+    struct Pool
+    {
+        Pool() : size_(0) {}
+
+        String objectFile_;
+        String scriptFile_;
+        String className_;
+        Vector<WeakPtr<Node> > freeNodes_;
+        unsigned size_;
+    };
+
+    struct PooledNode
+    {
+        StringHash pool_;
+        bool free_;
+    };
+
+    /// Build a new node for the pool, inactive.
+    Node* CreatePooledNode(Pool& pool, StringHash poolName);
+    /// Enable or disable the components of a pooled node and its children, parking or unparking its rigid bodies.
+    void SetNodeActive(Node* node, bool active);
+    /// Take a rigid body out of the simulation and collision filtering while keeping it in the physics world, or restore it.
+    void ParkBody(RigidBody* body, bool park);
+    /// Forget a pooled node that was removed from the pool root.
+    void HandleNodeRemoved(StringHash eventType, VariantMap& eventData);
+    /// Call an optional method of the node's script object.
+    void ExecuteScriptHook(Node* node, const String& declaration);
+    /// Clear physics state left from the previous use.
+    void ResetPhysics(Node* node);
+
+    HashMap<StringHash, Pool> pools_;
+    /// Owning pool and state of each pooled node by node ID.
+    HashMap<unsigned, PooledNode> pooledNodes_;
+    /// Parent of all pooled nodes.
+    WeakPtr<Node> poolRoot_;
+};
+
+#endif // NODEPOOL_H
@@ -0,0 +1,80 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Core/WorkQueue.h>
+
+#include "ParallelUpdate.h"
+
+ParallelUpdate::ParallelUpdate(Context *context) : Object(context)
+{
+
+}
+
+void ParallelUpdate::Run(unsigned count, unsigned minBatchSize, ParallelUpdateFunction function, void *data)
+{
+    if(count == 0)
+        return;
+
+    auto* queue = GetSubsystem<WorkQueue>();
+    unsigned numThreads = queue ? queue->GetNumThreads() : 0;
+    unsigned numBatches = Min(numThreads + 1, count / Max(minBatchSize, 1U));
+
+    if(numBatches <= 1)
+    {
+        function(data, 0, count);
+        return;
+    }
+
+    //even split, with the remainder spread over the first batches
+    batches_.Resize(numBatches);
+    unsigned start = 0;
+    for(unsigned i = 0; i < numBatches; ++i)
+    {
+        unsigned size = count / numBatches + (i < count % numBatches ? 1 : 0);
+
+        Batch& batch = batches_[i];
+        batch.function_ = function;
+        batch.data_ = data;
+        batch.start_ = start;
+        batch.end_ = start + size;
+        start += size;
+    }
+
+    for(unsigned i = 0; i < numBatches; ++i)
+    {
+        SharedPtr<WorkItem> item = queue->GetFreeItem();
+        item->priority_ = M_MAX_UNSIGNED;
+        item->workFunction_ = RunBatch;
+        item->aux_ = &batches_[i];
+        queue->AddWorkItem(item);
+    }
+
+    //the main thread works on the batches as well until all are done
+    queue->Complete(M_MAX_UNSIGNED);
+}
+
+void ParallelUpdate::RunBatch(const WorkItem *item, unsigned threadIndex)
+{
+    auto* batch = static_cast<const Batch*>(item->aux_);
+    batch->function_(batch->data_, batch->start_, batch->end_);
+}
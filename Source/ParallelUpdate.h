@@ -0,0 +1,68 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef PARALLELUPDATE_H
+#define PARALLELUPDATE_H
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Core/Object.h>
+
+namespace Urho3D
+{
+    struct WorkItem;
+}
+
+using namespace Urho3D;
+
+/// Function that updates the entities from start up to end.
+typedef void (*ParallelUpdateFunction)(void* data, unsigned start, unsigned end);
+
+/// Runs per-entity gameplay work in batches on the engine's worker threads and waits for all of them. The work may
+/// only read shared state and write to its own range of entities; writes to the scene are merged afterwards by the
+/// caller, in entity order, on the main thread. Without worker threads, as on the web, the work runs inline.
+class ParallelUpdate : public Object
+{
+    URHO3D_OBJECT(ParallelUpdate, Object)
+
+public:
+    ParallelUpdate(Context* context);
+
+    /// Run the function over the entities from 0 up to count, in batches of at least minBatchSize entities.
+    void Run(unsigned count, unsigned minBatchSize, ParallelUpdateFunction function, void* data);
+
+private:
+    /// Work item function that runs one batch.
+    static void RunBatch(const WorkItem* item, unsigned threadIndex);
+
+    struct Batch
+    {
+        ParallelUpdateFunction function_;
+        void* data_;
+        unsigned start_;
+        unsigned end_;
+    };
+
+    /// Batches of the current run, referenced by the work items.
+    PODVector<Batch> batches_;
+};
+
+#endif // PARALLELUPDATE_H
@@ -0,0 +1,281 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <cstdio>
+
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Core/CoreEvents.h>
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/Container/Sort.h>
+#include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/UI/Font.h>
+#include <Urho3D/UI/Text.h>
+#include <Urho3D/UI/UI.h>
+
+#include "PerfCounters.h"
+#include "ResourceBudget.h"
+
+//Number of frames the rolling statistics are taken over
+static const unsigned HISTORY_SIZE = 240;
+//Seconds between overlay refreshes
+static const float OVERLAY_UPDATE_TIME = 0.5f;
+
+PerfCounters::PerfCounters(Context *context) : Object(context)
+, overlayTimer_(0.0f)
+, csvInterval_(0.0f)
+, csvTimer_(0.0f)
+, elapsedTime_(0.0f)
+{
+    SubscribeToEvent(E_ENDFRAME, URHO3D_HANDLER(PerfCounters, HandleEndFrame));
+}
+
+PerfCounters::~PerfCounters()
+{
+    if(overlay_)
+    {
+        overlay_->Remove();
+    }
+}
+
+void PerfCounters::BeginScope(const char *name)
+{
+    scopeStack_.Push(GetCounterIndex(name));
+    scopeStarts_.Push(clock_.GetUSec(false));
+}
+
+void PerfCounters::EndScope()
+{
+    if(scopeStack_.Empty())
+    {
+        URHO3D_LOGWARNING("PerfCounters::EndScope called without an open scope");
+        return;
+    }
+
+    Counter& counter = counters_[scopeStack_.Back()];
+    counter.frameTime_ += clock_.GetUSec(false) - scopeStarts_.Back();
+    ++counter.frameCalls_;
+
+    scopeStack_.Pop();
+    scopeStarts_.Pop();
+}
+
+void PerfCounters::SetOverlayVisible(bool enable)
+{
+    if(enable && !overlay_)
+    {
+        auto* ui = GetSubsystem<UI>();
+        auto* font = GetSubsystem<ResourceCache>()->GetResource<Font>("Fonts/Anonymous Pro.ttf");
+        if(!ui || !font)
+            return;
+
+        overlay_ = ui->GetRoot()->CreateChild<Text>();
+        overlay_->SetFont(font, 10);
+        overlay_->SetAlignment(HA_LEFT, VA_TOP);
+        overlay_->SetPosition(10, 10);
+        overlay_->SetTextEffect(TE_SHADOW);
+        overlay_->SetPriority(100);
+        UpdateOverlay();
+    }
+
+    if(overlay_)
+    {
+        overlay_->SetVisible(enable);
+    }
+}
+
+void PerfCounters::SetCsvInterval(float interval)
+{
+    csvInterval_ = Max(interval, 0.0f);
+    csvTimer_ = 0.0f;
+}
+
+bool PerfCounters::IsOverlayVisible() const
+{
+    return overlay_ && overlay_->IsVisible();
+}
+
+void PerfCounters::HandleEndFrame(StringHash eventType, VariantMap &eventData)
+{
+    //scopes left open, e.g. by a script exception, are closed so they do not leak into the next frame
+    if(!scopeStack_.Empty())
+    {
+        URHO3D_LOGWARNING("PerfCounters closing " + String(scopeStack_.Size()) + " unbalanced scope(s)");
+        while(!scopeStack_.Empty())
+        {
+            EndScope();
+        }
+    }
+
+    for(unsigned i = 0; i < counters_.Size(); ++i)
+    {
+        Counter& counter = counters_[i];
+
+        if(counter.history_.Size() < HISTORY_SIZE)
+        {
+            counter.history_.Push(counter.frameTime_ / 1000.0f);
+        }
+        else
+        {
+            counter.history_[counter.historyPos_] = counter.frameTime_ / 1000.0f;
+        }
+
+        counter.historyPos_ = (counter.historyPos_ + 1) % HISTORY_SIZE;
+        counter.totalCalls_ += counter.frameCalls_;
+        counter.frameTime_ = 0;
+        counter.frameCalls_ = 0;
+    }
+
+    float timeStep = GetSubsystem<Time>()->GetTimeStep();
+    elapsedTime_ += timeStep;
+
+    if(IsOverlayVisible())
+    {
+        overlayTimer_ += timeStep;
+        if(overlayTimer_ >= OVERLAY_UPDATE_TIME)
+        {
+            UpdateOverlay();
+            overlayTimer_ = 0.0f;
+        }
+    }
+
+    if(csvInterval_ > 0.0f)
+    {
+        csvTimer_ += timeStep;
+        if(csvTimer_ >= csvInterval_)
+        {
+            WriteCsv();
+            csvTimer_ = 0.0f;
+        }
+    }
+}
+
+unsigned PerfCounters::GetCounterIndex(const char *name)
+{
+    StringHash nameHash(name);
+
+    auto it = counterIndices_.Find(nameHash);
+    if(it != counterIndices_.End())
+        return it->second_;
+
+    unsigned index = counters_.Size();
+    counters_.Resize(index + 1);
+    counters_[index].name_ = name;
+    counterIndices_[nameHash] = index;
+
+    return index;
+}
+
+PerfCounters::Summary PerfCounters::GetSummary(const Counter &counter) const
+{
+    Summary summary = {0.0f, 0.0f, 0.0f, 0.0f};
+    if(counter.history_.Empty())
+        return summary;
+
+    PODVector<float> sorted(counter.history_);
+    Sort(sorted.Begin(), sorted.End());
+
+    float total = 0.0f;
+    for(unsigned i = 0; i < sorted.Size(); ++i)
+    {
+        total += sorted[i];
+    }
+
+    summary.min_ = sorted.Front();
+    summary.average_ = total / sorted.Size();
+    summary.p99_ = sorted[(unsigned)(0.99f * (sorted.Size() - 1) + 0.5f)];
+    summary.max_ = sorted.Back();
+
+    return summary;
+}
+
+void PerfCounters::UpdateOverlay()
+{
+    if(!overlay_)
+        return;
+
+    String text = "Scope (ms per frame)                    min     avg     p99\n";
+    char line[128];
+
+    for(unsigned i = 0; i < counters_.Size(); ++i)
+    {
+        Summary summary = GetSummary(counters_[i]);
+
+        //scope names come from scripts and are unbounded, only the numbers go through the fixed size buffer
+        const String& name = counters_[i].name_;
+        text += name;
+        if(name.Length() < 36)
+            text += String(' ', 36 - name.Length());
+
+        snprintf(line, sizeof(line), " %7.3f %7.3f %7.3f\n", summary.min_, summary.average_, summary.p99_);
+        text += line;
+    }
+
+    auto* budget = GetSubsystem<ResourceBudget>();
+    if(budget)
+    {
+        text += "\n" + budget->GetOverlayText();
+    }
+
+    overlay_->SetText(text);
+}
+
+void PerfCounters::WriteCsv()
+{
+    if(!csvFile_)
+    {
+        auto* fileSystem = GetSubsystem<FileSystem>();
+        String dirName = fileSystem->GetCurrentDir() + "AppLog";
+        if(!fileSystem->DirExists(dirName))
+        {
+            fileSystem->CreateDir(dirName);
+        }
+
+        csvFile_ = new File(context_, dirName + "/PerfCounters.csv", FILE_WRITE);
+        if(!csvFile_->IsOpen())
+        {
+            csvFile_.Reset();
+            csvInterval_ = 0.0f;
+            return;
+        }
+
+        csvFile_->WriteLine("time,scope,calls,min_ms,avg_ms,p99_ms,max_ms");
+    }
+
+    char line[128];
+
+    for(unsigned i = 0; i < counters_.Size(); ++i)
+    {
+        const Counter& counter = counters_[i];
+        Summary summary = GetSummary(counter);
+        snprintf(line, sizeof(line), "%.2f,", elapsedTime_);
+        String row(line);
+        row += counter.name_;
+        snprintf(line, sizeof(line), ",%u,%.4f,%.4f,%.4f,%.4f", counter.totalCalls_, summary.min_, summary.average_,
+            summary.p99_, summary.max_);
+        row += line;
+        csvFile_->WriteLine(row);
+    }
+
+    csvFile_->Flush();
+}
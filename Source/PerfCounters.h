@@ -0,0 +1,138 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef PERFCOUNTERS_H
+#define PERFCOUNTERS_H
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Core/Object.h>
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/Container/HashMap.h>
+#include <Urho3D/IO/File.h>
+
+namespace Urho3D
+{
+    class Text;
+}
+
+using namespace Urho3D;
+
+/// Named gameplay timing scopes. Scope times are summed per frame and kept for a rolling window of frames,
+/// from which min, average and 99th percentile are shown in an overlay and written to a CSV file.
+class PerfCounters : public Object
+{
+    URHO3D_OBJECT(PerfCounters, Object)
+
+public:
+    PerfCounters(Context* context);
+    ~PerfCounters() override;
+
+    /// Open a timing scope. Scopes may nest and the same name may be opened several times per frame.
+    void BeginScope(const char* name);
+    /// Open a timing scope.
+    void BeginScope(const String& name) { BeginScope(name.CString()); }
+    /// Close the innermost timing scope.
+    void EndScope();
+
+    /// Show or hide the overlay.
+    void SetOverlayVisible(bool enable);
+    /// Toggle the overlay.
+    void ToggleOverlay() { SetOverlayVisible(!IsOverlayVisible()); }
+    /// Set the CSV write interval in seconds, 0 to disable. The file is created in the AppLog directory.
+    void SetCsvInterval(float interval);
+
+    /// Return whether the overlay is shown.
+    bool IsOverlayVisible() const;
+    /// Return the CSV write interval.
+    float GetCsvInterval() const { return csvInterval_; }
+
+private:
+    /// Timing of one scope name.
+    struct Counter
+    {
+        Counter() : frameTime_(0), frameCalls_(0), totalCalls_(0), historyPos_(0) {}
+
+        String name_;
+        /// Time accumulated in the current frame in microseconds.
+        long long frameTime_;
+        unsigned frameCalls_;
+        unsigned totalCalls_;
+        /// Per-frame times of the rolling window in milliseconds.
+        PODVector<float> history_;
+        unsigned historyPos_;
+    };
+
+    /// Rolling window statistics in milliseconds.
+    struct Summary
+    {
+        float min_;
+        float average_;
+        float p99_;
+        float max_;
+    };
+
+    void HandleEndFrame(StringHash eventType, VariantMap& eventData);
+
+    /// Return counter index by name, creating the counter on first use.
+    unsigned GetCounterIndex(const char* name);
+    Summary GetSummary(const Counter& counter) const;
+    void UpdateOverlay();
+    void WriteCsv();
+
+    Vector<Counter> counters_;
+    /// Scope name to counter index lookup.
+    HashMap<StringHash, unsigned> counterIndices_;
+    /// Open scopes as counter indices with their start times.
+    PODVector<unsigned> scopeStack_;
+    PODVector<long long> scopeStarts_;
+    HiresTimer clock_;
+
+    SharedPtr<Text> overlay_;
+    float overlayTimer_;
+
+    SharedPtr<File> csvFile_;
+    float csvInterval_;
+    float csvTimer_;
+    float elapsedTime_;
+};
+
+/// Times the enclosing block as a named scope.
+class PerfScope
+{
+public:
+    PerfScope(PerfCounters* counters, const char* name) : counters_(counters)
+    {
+        if(counters_)
+            counters_->BeginScope(name);
+    }
+
+    ~PerfScope()
+    {
+        if(counters_)
+            counters_->EndScope();
+    }
+
+private:
+    PerfCounters* counters_;
+};
+
+#endif // PERFCOUNTERS_H
@@ -0,0 +1,66 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Core/CoreEvents.h>
+#include <Urho3D/Input/Input.h>
+
+#include "PlayerInput.h"
+
+PlayerInput::PlayerInput(Context *context) : Object(context)
+, lookDelta_(IntVector2::ZERO)
+, lookEventCount_(0)
+, firePressed_(false)
+, numJoysticks_(-1)
+{
+    SubscribeToEvent(E_ENDFRAME, URHO3D_HANDLER(PlayerInput, HandleEndFrame));
+}
+
+void PlayerInput::AddLookDelta(int dx, int dy)
+{
+    lookDelta_.x_ += dx;
+    lookDelta_.y_ += dy;
+    ++lookEventCount_;
+}
+
+IntVector2 PlayerInput::TakeLookDelta()
+{
+    IntVector2 delta = lookDelta_;
+    lookDelta_ = IntVector2::ZERO;
+    return delta;
+}
+
+unsigned PlayerInput::GetNumJoysticks() const
+{
+    if(numJoysticks_ >= 0)
+        return (unsigned)numJoysticks_;
+
+    return GetSubsystem<Input>()->GetNumJoysticks();
+}
+
+void PlayerInput::HandleEndFrame(StringHash eventType, VariantMap &eventData)
+{
+    //input nobody took this frame is dropped, the player look only takes it while the level scene updates
+    lookDelta_ = IntVector2::ZERO;
+    lookEventCount_ = 0;
+    firePressed_ = false;
+}
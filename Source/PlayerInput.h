@@ -0,0 +1,70 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef PLAYERINPUT_H
+#define PLAYERINPUT_H
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Core/Object.h>
+#include <Urho3D/Math/Vector2.h>
+
+using namespace Urho3D;
+
+/// Sums the look input of mouse, joystick hat and D-pad over a frame, so that the player look is applied once
+/// per frame however many input events arrive, and holds the fire press of the frame. Input that is not taken by
+/// the end of the frame is dropped.
+class PlayerInput : public Object
+{
+    URHO3D_OBJECT(PlayerInput, Object)
+
+public:
+    PlayerInput(Context* context);
+
+    /// Add a look delta in input units.
+    void AddLookDelta(int dx, int dy);
+    /// Return the look delta of the frame so far and reset it.
+    IntVector2 TakeLookDelta();
+
+    /// Press fire for the frame.
+    void PressFire() { firePressed_ = true; }
+    /// Set number of joysticks the level sees, or negative to use the connected ones. Used by replays.
+    void SetNumJoysticks(int count) { numJoysticks_ = count; }
+
+    /// Return whether fire was pressed in the frame.
+    bool IsFirePressed() const { return firePressed_; }
+    /// Return number of joysticks the level sees.
+    unsigned GetNumJoysticks() const;
+    /// Return the look delta of the frame so far.
+    const IntVector2& GetLookDelta() const { return lookDelta_; }
+    /// Return number of look deltas added in the frame so far.
+    unsigned GetLookEventCount() const { return lookEventCount_; }
+
+private:
+    void HandleEndFrame(StringHash eventType, VariantMap& eventData);
+
+    IntVector2 lookDelta_;
+    unsigned lookEventCount_;
+    bool firePressed_;
+    int numJoysticks_;
+};
+
+#endif // PLAYERINPUT_H
@@ -0,0 +1,103 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Core/CoreEvents.h>
+#include <Urho3D/Scene/Scene.h>
+
+#include "EventsAndDefs.h"
+#include "GameEventChannel.h"
+#include "PlayerInput.h"
+#include "PlayerLook.h"
+
+PlayerLook::PlayerLook(Context *context) : Component(context)
+, sensitivity_(0.25f)
+, minPitch_(-20.0f)
+, maxPitch_(70.0f)
+, cameraNodeName_("CameraNode")
+{
+
+}
+
+void PlayerLook::RegisterObject(Context *context)
+{
+    context->RegisterFactory<PlayerLook>();
+
+    URHO3D_ATTRIBUTE("Sensitivity", sensitivity_, 0.25f, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Min Pitch", minPitch_, -20.0f, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Max Pitch", maxPitch_, 70.0f, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Camera Node Name", cameraNodeName_, String("CameraNode"), AM_DEFAULT);
+}
+
+void PlayerLook::SetPitchRange(float minPitch, float maxPitch)
+{
+    minPitch_ = minPitch;
+    maxPitch_ = Max(minPitch, maxPitch);
+}
+
+void PlayerLook::OnNodeSet(Node *node)
+{
+    if(node)
+    {
+        //after the level update, which adds the joystick input, and before rendering
+        SubscribeToEvent(E_POSTUPDATE, URHO3D_HANDLER(PlayerLook, HandlePostUpdate));
+    }
+    else
+    {
+        UnsubscribeFromEvent(E_POSTUPDATE);
+    }
+}
+
+void PlayerLook::HandlePostUpdate(StringHash eventType, VariantMap &eventData)
+{
+    //the level only updates its scene in game, while it is paused, counting down or over the input is dropped
+    IntVector2 delta = GetSubsystem<PlayerInput>()->TakeLookDelta();
+    Scene* scene = GetScene();
+    if(!IsEnabledEffective() || !scene || !scene->IsUpdateEnabled())
+        return;
+
+    if(delta == IntVector2::ZERO)
+        return;
+
+    if(!cameraNode_)
+    {
+        cameraNode_ = node_->GetChild(cameraNodeName_);
+        if(!cameraNode_)
+            return;
+    }
+
+    float yaw = node_->GetRotation().YawAngle() + delta.x_ * sensitivity_;
+    float pitch = Clamp(cameraNode_->GetRotation().PitchAngle() + delta.y_ * sensitivity_, minPitch_, maxPitch_);
+
+    cameraNode_->SetRotation(Quaternion(pitch, 0.0f, 0.0f));
+    node_->SetRotation(Quaternion(0.0f, yaw, 0.0f));
+
+    PlayerRotation::Data event;
+    event.dx_ = delta.x_;
+    event.dy_ = delta.y_;
+
+    //the channel has already delivered this post update's events, the radar is drawn with the new heading only if
+    //the rotation reaches it before the frame is rendered
+    auto* channel = GetSubsystem<GameEventChannel>();
+    channel->Post(event);
+    channel->Flush();
+}
@@ -0,0 +1,65 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef PLAYERLOOK_H
+#define PLAYERLOOK_H
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Scene/Component.h>
+#include <Urho3D/Scene/Node.h>
+
+using namespace Urho3D;
+
+/// Turns the player node and pitches its camera child by the look input of the frame. The input is applied
+/// once after the update, so the frame is rendered with all of the input received up to then. Input received while
+/// the scene does not update, i.e. the level is paused, counting down or over, is dropped.
+class PlayerLook : public Component
+{
+    URHO3D_OBJECT(PlayerLook, Component)
+
+public:
+    PlayerLook(Context* context);
+
+    static void RegisterObject(Context* context);
+
+    /// Set degrees turned per input unit.
+    void SetSensitivity(float sensitivity) { sensitivity_ = sensitivity; }
+    /// Set camera pitch limits in degrees.
+    void SetPitchRange(float minPitch, float maxPitch);
+
+    /// Return degrees turned per input unit.
+    float GetSensitivity() const { return sensitivity_; }
+
+protected:
+    void OnNodeSet(Node* node) override;
+
+private:
+    void HandlePostUpdate(StringHash eventType, VariantMap& eventData);
+
+    float sensitivity_;
+    float minPitch_;
+    float maxPitch_;
+    String cameraNodeName_;
+    WeakPtr<Node> cameraNode_;
+};
+
+#endif // PLAYERLOOK_H
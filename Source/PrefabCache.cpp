@@ -0,0 +1,138 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/IO/MemoryBuffer.h>
+#include <Urho3D/Scene/Scene.h>
+#include <Urho3D/Scene/SceneResolver.h>
+#include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/Resource/ResourceEvents.h>
+#include <Urho3D/Resource/XMLFile.h>
+
+#include "PrefabCache.h"
+
+PrefabCache::PrefabCache(Context *context) : Object(context)
+{
+
+}
+
+bool PrefabCache::LoadPrefab(const String &name)
+{
+    StringHash nameHash(name);
+    if(prefabs_.Contains(nameHash))
+        return true;
+
+    auto* cache = GetSubsystem<ResourceCache>();
+    XMLFile* file = cache->GetResource<XMLFile>(name);
+    if(!file)
+        return false;
+
+    VectorBuffer data;
+    if(!CompilePrefab(file, data))
+    {
+        URHO3D_LOGERROR("Failed to compile prefab " + name);
+        return false;
+    }
+
+    prefabs_[nameHash] = data;
+
+    //object file changes are picked up when the resource cache reloads the file
+    SubscribeToEvent(file, E_RELOADFINISHED, URHO3D_HANDLER(PrefabCache, HandlePrefabReloaded));
+
+    return true;
+}
+
+Node* PrefabCache::SpawnPrefab(Scene *scene, const String &name, const Vector3 &position, const Quaternion &rotation, CreateMode mode)
+{
+    return InstantiatePrefab(scene, name, position, rotation, mode);
+}
+
+Node* PrefabCache::InstantiatePrefab(Node *parent, const String &name, const Vector3 &position, const Quaternion &rotation, CreateMode mode)
+{
+    if(!parent || !LoadPrefab(name))
+        return nullptr;
+
+    const VectorBuffer& data = prefabs_[StringHash(name)];
+    MemoryBuffer source(data.GetData(), data.GetSize());
+
+    //same as Scene::Instantiate, but for any parent node
+    SceneResolver resolver;
+    unsigned nodeID = source.ReadUInt();
+    Node* node = parent->CreateChild(0, mode);
+    resolver.AddNode(nodeID, node);
+
+    if(!node->Load(source, resolver, true, true, mode))
+    {
+        node->Remove();
+        return nullptr;
+    }
+
+    resolver.Resolve();
+    node->SetTransform(position, rotation);
+    node->ApplyAttributes();
+
+    return node;
+}
+
+void PrefabCache::ReleasePrefab(const String &name)
+{
+    prefabs_.Erase(StringHash(name));
+}
+
+bool PrefabCache::CompilePrefab(XMLFile *file, VectorBuffer &dest)
+{
+    if(!compileScene_)
+    {
+        compileScene_ = new Scene(context_);
+    }
+
+    Node* node = compileScene_->CreateChild(String::EMPTY, LOCAL);
+    bool success = node->LoadXML(file->GetRoot());
+
+    if(success)
+    {
+        dest.Clear();
+        success = node->Save(dest);
+    }
+
+    node->Remove();
+    return success;
+}
+
+void PrefabCache::HandlePrefabReloaded(StringHash eventType, VariantMap &eventData)
+{
+    auto* file = static_cast<XMLFile*>(GetEventSender());
+    if(!file)
+        return;
+
+    VectorBuffer data;
+    if(CompilePrefab(file, data))
+    {
+        prefabs_[StringHash(file->GetName())] = data;
+        URHO3D_LOGINFO("Recompiled prefab " + file->GetName());
+    }
+    else
+    {
+        URHO3D_LOGERROR("Failed to recompile prefab " + file->GetName() + ", keeping the previous version");
+    }
+}
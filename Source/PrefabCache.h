@@ -0,0 +1,72 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef PREFABCACHE_H
+#define PREFABCACHE_H
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Core/Object.h>
+#include <Urho3D/Container/HashMap.h>
+#include <Urho3D/IO/VectorBuffer.h>
+#include <Urho3D/Scene/Node.h>
+
+namespace Urho3D
+{
+    class Scene;
+    class XMLFile;
+}
+
+using namespace Urho3D;
+
+/// Compiles object XML files once into binary node data and instantiates them from memory.
+/// Prefabs are named after their object file and recompiled when the file is reloaded.
+class PrefabCache : public Object
+{
+    URHO3D_OBJECT(PrefabCache, Object)
+
+public:
+    PrefabCache(Context* context);
+
+    /// Compile the prefab ahead of its first use. Return true if it is ready.
+    bool LoadPrefab(const String& name);
+    /// Instantiate a prefab as a child of the scene.
+    Node* SpawnPrefab(Scene* scene, const String& name, const Vector3& position, const Quaternion& rotation, CreateMode mode = REPLICATED);
+    /// Instantiate a prefab as a child of any node.
+    Node* InstantiatePrefab(Node* parent, const String& name, const Vector3& position, const Quaternion& rotation, CreateMode mode = REPLICATED);
+    /// Drop the compiled data of a prefab.
+    void ReleasePrefab(const String& name);
+    /// Return whether the prefab is compiled.
+    bool HasPrefab(const String& name) const { return prefabs_.Contains(StringHash(name)); }
+
+private:
+    /// Load the object XML into a scratch node and save it in binary form.
+    bool CompilePrefab(XMLFile* file, VectorBuffer& dest);
+    /// Recompile a prefab whose object file was reloaded.
+    void HandlePrefabReloaded(StringHash eventType, VariantMap& eventData);
+
+    /// Compiled node data by prefab name.
+    HashMap<StringHash, VectorBuffer> prefabs_;
+    /// Scene the prefabs are built in while compiling.
+    SharedPtr<Scene> compileScene_;
+};
+
+#endif // PREFABCACHE_H
@@ -0,0 +1,439 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Scene/Scene.h>
+#include <Urho3D/Scene/SceneEvents.h>
+#include <Urho3D/Graphics/ParticleEmitter.h>
+#include <Urho3D/Physics/CollisionShape.h>
+#include <Urho3D/Physics/PhysicsEvents.h>
+#include <Urho3D/Physics/PhysicsWorld.h>
+#include <Urho3D/Physics/RigidBody.h>
+#include <Urho3D/AngelScript/Script.h>
+#include <Urho3D/AngelScript/ScriptInstance.h>
+
+#include "EventsAndDefs.h"
+#include "DroneSwarmSystem.h"
+#include "EntityIndex.h"
+#include "NodePool.h"
+#include "ParallelUpdate.h"
+#include "PerfCounters.h"
+#include "SimulationClock.h"
+#include "ProjectileSystem.h"
+
+//Fewest projectiles worth a batch of their own on a worker thread
+static const unsigned MIN_PARALLEL_PROJECTILES = 128;
+
+//Number of hash buckets of the target grid, a power of two
+static const unsigned GRID_BUCKETS = 256;
+
+/// Return the grid bucket of a cell.
+static inline unsigned GetGridBucket(int x, int z)
+{
+    return ((unsigned)x * 73856093u ^ (unsigned)z * 19349663u) & (GRID_BUCKETS - 1);
+}
+
+/// Return the earliest fraction of the sweep at which a moving sphere touches a static one, or a value above 1 if never.
+static float SweepSphere(const Vector3& start, const Vector3& move, const Vector3& center, float radius)
+{
+    Vector3 offset = start - center;
+    float c = offset.DotProduct(offset) - radius * radius;
+    if(c <= 0.0f)
+        return 0.0f;
+
+    float b = offset.DotProduct(move);
+    if(b >= 0.0f)
+        return M_INFINITY;
+
+    float a = move.DotProduct(move);
+    float discriminant = b * b - a * c;
+    if(discriminant < 0.0f)
+        return M_INFINITY;
+
+    return (-b - sqrtf(discriminant)) / a;
+}
+
+ProjectileSystem::ProjectileSystem(Context *context) : Component(context)
+, speed_(70.0f)
+, lifeTime_(1.0f)
+, radius_(0.15f)
+, damagePoint_(1.0f)
+, collisionLayer_(BULLET_COLLISION_LAYER)
+, collisionMask_(DRONE_COLLISION_LAYER | FLOOR_COLLISION_LAYER)
+, floorHeight_(0.0f)
+, floorCollisionLayer_(FLOOR_COLLISION_LAYER)
+, gridCellSize_(4.0f)
+, visualPool_("BulletVisual")
+, stepTime_(0.0f)
+, droneHitMethod_("void OnHit(float)")
+{
+
+}
+
+void ProjectileSystem::RegisterObject(Context *context)
+{
+    context->RegisterFactory<ProjectileSystem>();
+
+    //same values as the LowLevelBullet script object
+    URHO3D_ATTRIBUTE("Speed", speed_, 70.0f, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Life Time", lifeTime_, 1.0f, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Radius", radius_, 0.15f, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Damage Point", damagePoint_, 1.0f, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Collision Layer", collisionLayer_, BULLET_COLLISION_LAYER, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Collision Mask", collisionMask_, DRONE_COLLISION_LAYER | FLOOR_COLLISION_LAYER, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Floor Height", floorHeight_, 0.0f, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Floor Collision Layer", floorCollisionLayer_, FLOOR_COLLISION_LAYER, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Grid Cell Size", gridCellSize_, 4.0f, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Visual Pool", visualPool_, String("BulletVisual"), AM_DEFAULT);
+}
+
+void ProjectileSystem::Fire(const Vector3 &position, const Quaternion &rotation)
+{
+    Scene* scene = GetScene();
+    if(!scene)
+        return;
+
+    Node* visualNode = nullptr;
+    auto* nodePool = scene->GetComponent<NodePool>();
+    if(nodePool)
+    {
+        visualNode = nodePool->Acquire(visualPool_, position, rotation);
+    }
+
+    //restart the trail, as in Bullet::OnAcquired
+    auto* emitter = visualNode ? visualNode->GetComponent<ParticleEmitter>() : nullptr;
+    if(emitter)
+    {
+        emitter->RemoveAllParticles();
+        emitter->Reset();
+    }
+
+    positions_.Push(position);
+    previousPositions_.Push(position);
+    velocities_.Push(rotation * Vector3(0.0f, 0.0f, speed_));
+    ages_.Push(0.0f);
+    nodes_.Push(WeakPtr<Node>(visualNode));
+}
+
+void ProjectileSystem::RemoveAllProjectiles()
+{
+    for(unsigned i = nodes_.Size(); i-- > 0;)
+    {
+        RemoveProjectile(i);
+    }
+}
+
+void ProjectileSystem::OnSceneSet(Scene *scene)
+{
+    if(scene)
+    {
+        auto* physicsWorld = scene->GetComponent<PhysicsWorld>();
+        if(physicsWorld)
+        {
+            SubscribeToEvent(physicsWorld, E_PHYSICSPRESTEP, URHO3D_HANDLER(ProjectileSystem, HandlePhysicsPreStep));
+        }
+
+        SubscribeToEvent(scene, E_SCENEPOSTUPDATE, URHO3D_HANDLER(ProjectileSystem, HandleScenePostUpdate));
+    }
+    else
+    {
+        UnsubscribeFromEvent(E_PHYSICSPRESTEP);
+        UnsubscribeFromEvent(E_SCENEPOSTUPDATE);
+    }
+}
+
+void ProjectileSystem::HandlePhysicsPreStep(StringHash eventType, VariantMap &eventData)
+{
+    using namespace PhysicsPreStep;
+
+    if(positions_.Empty())
+        return;
+
+    PerfScope scope(GetSubsystem<PerfCounters>(), "ProjectileSystem::Update");
+    float timeStep = eventData[P_TIMESTEP].GetFloat();
+
+    BuildTargetGrid();
+
+    const unsigned count = positions_.Size();
+    stepTime_ = timeStep;
+    hitTimes_.Resize(count);
+    hitTargets_.Resize(count);
+
+    //the sweeps run on the worker threads, hits and removals are applied here in projectile order
+    GetSubsystem<ParallelUpdate>()->Run(count, MIN_PARALLEL_PROJECTILES, SweepProjectiles, this);
+
+    //iterate backwards so that the swap on removal only moves projectiles that were already handled
+    for(unsigned i = count; i-- > 0;)
+    {
+        if(hitTimes_[i] <= 1.0f)
+        {
+            if(hitTargets_[i] != M_MAX_UNSIGNED)
+                targetDamage_[hitTargets_[i]] += damagePoint_;
+
+            RemoveProjectile(i);
+            continue;
+        }
+
+        ages_[i] += timeStep;
+        if(ages_[i] >= lifeTime_)
+        {
+            RemoveProjectile(i);
+            continue;
+        }
+
+        previousPositions_[i] = positions_[i];
+        positions_[i] += velocities_[i] * timeStep;
+    }
+
+    DeliverHits();
+}
+
+void ProjectileSystem::HandleScenePostUpdate(StringHash eventType, VariantMap &eventData)
+{
+    //the visuals are drawn between the last two steps, nothing reads their positions back
+    auto* clock = GetScene()->GetComponent<SimulationClock>();
+    float t = clock ? clock->GetInterpolation() : 1.0f;
+    const unsigned count = nodes_.Size();
+
+    for(unsigned i = 0; i < count; ++i)
+    {
+        if(nodes_[i])
+        {
+            nodes_[i]->SetWorldPosition(previousPositions_[i].Lerp(positions_[i], t));
+        }
+    }
+}
+
+void ProjectileSystem::SweepProjectiles(void *data, unsigned start, unsigned end)
+{
+    auto* system = static_cast<ProjectileSystem*>(data);
+
+    const bool hitsFloor = (system->collisionMask_ & system->floorCollisionLayer_) != 0;
+    const float floorLevel = system->floorHeight_ + system->radius_;
+
+    for(unsigned i = start; i < end; ++i)
+    {
+        Vector3 from = system->positions_[i];
+        Vector3 to = from + system->velocities_[i] * system->stepTime_;
+
+        unsigned targetIndex = M_MAX_UNSIGNED;
+        float hitTime = system->SweepTargets(from, to, targetIndex);
+
+        //the floor is only hit if no drone is hit before it
+        if(hitsFloor && from.y_ > floorLevel && to.y_ <= floorLevel)
+        {
+            float floorTime = (from.y_ - floorLevel) / (from.y_ - to.y_);
+            if(floorTime < hitTime)
+            {
+                hitTime = floorTime;
+                targetIndex = M_MAX_UNSIGNED;
+            }
+        }
+
+        system->hitTimes_[i] = hitTime;
+        system->hitTargets_[i] = targetIndex;
+    }
+}
+
+void ProjectileSystem::BuildTargetGrid()
+{
+    targetCenters_.Clear();
+    targetRadii_.Clear();
+    targetNodes_.Clear();
+
+    auto* entityIndex = GetScene()->GetOrCreateComponent<EntityIndex>(LOCAL);
+    auto* droneSwarm = GetScene()->GetComponent<DroneSwarmSystem>();
+    const Vector<WeakPtr<Node> >& drones = entityIndex->GetTaggedNodes("drone");
+
+    for(unsigned i = 0; i < drones.Size(); ++i)
+    {
+        Node* droneNode = drones[i];
+        if(!droneNode || !droneNode->IsEnabled())
+            continue;
+
+        //same layer and mask test as the physics world applies between two bodies
+        auto* body = droneNode->GetComponent<RigidBody>();
+        auto* shape = droneNode->GetComponent<CollisionShape>();
+        if(!body || !shape || !(body->GetCollisionLayer() & collisionMask_) || !(body->GetCollisionMask() & collisionLayer_))
+            continue;
+
+        Vector3 worldScale = droneNode->GetWorldScale();
+        float scale = Max(Max(worldScale.x_, worldScale.y_), worldScale.z_);
+        const Vector3& size = shape->GetSize();
+
+        //the sweep runs against the simulated positions, the nodes may be drawn between steps. Approaching swarm
+        //drones are moved by the swarm, everything else by its body
+        Vector3 position;
+        if(!droneSwarm || !droneSwarm->GetSimulatedPosition(droneNode, position))
+            position = body->GetPosition();
+
+        targetCenters_.Push(Matrix3x4(position, droneNode->GetWorldRotation(), worldScale) * shape->GetPosition());
+        targetRadii_.Push(Max(Max(size.x_, size.y_), size.z_) * scale * 0.5f + radius_);
+        targetNodes_.Push(WeakPtr<Node>(droneNode));
+    }
+
+    targetDamage_.Resize(targetNodes_.Size());
+    for(unsigned i = 0; i < targetDamage_.Size(); ++i)
+    {
+        targetDamage_[i] = 0.0f;
+    }
+
+    //counting sort of the targets into every bucket their bounds overlap on the ground plane
+    gridStarts_.Resize(GRID_BUCKETS + 1);
+    for(unsigned i = 0; i <= GRID_BUCKETS; ++i)
+    {
+        gridStarts_[i] = 0;
+    }
+
+    const float invCellSize = 1.0f / gridCellSize_;
+
+    for(int pass = 0; pass < 2; ++pass)
+    {
+        for(unsigned i = 0; i < targetCenters_.Size(); ++i)
+        {
+            const Vector3& center = targetCenters_[i];
+            float radius = targetRadii_[i];
+            int minX = FloorToInt((center.x_ - radius) * invCellSize);
+            int maxX = FloorToInt((center.x_ + radius) * invCellSize);
+            int minZ = FloorToInt((center.z_ - radius) * invCellSize);
+            int maxZ = FloorToInt((center.z_ + radius) * invCellSize);
+
+            for(int x = minX; x <= maxX; ++x)
+            {
+                for(int z = minZ; z <= maxZ; ++z)
+                {
+                    unsigned bucket = GetGridBucket(x, z);
+                    if(pass == 0)
+                        ++gridStarts_[bucket + 1];
+                    else
+                        gridEntries_[gridStarts_[bucket]++] = i;
+                }
+            }
+        }
+
+        if(pass == 0)
+        {
+            for(unsigned j = 0; j < GRID_BUCKETS; ++j)
+            {
+                gridStarts_[j + 1] += gridStarts_[j];
+            }
+
+            gridEntries_.Resize(gridStarts_[GRID_BUCKETS]);
+        }
+    }
+
+    //the fill pass advanced each start to the end of its bucket, which is the start of the next one
+    for(unsigned j = GRID_BUCKETS; j > 0; --j)
+    {
+        gridStarts_[j] = gridStarts_[j - 1];
+    }
+    gridStarts_[0] = 0;
+}
+
+float ProjectileSystem::SweepTargets(const Vector3 &start, const Vector3 &end, unsigned &targetIndex) const
+{
+    float hitTime = M_INFINITY;
+    if(targetCenters_.Empty())
+        return hitTime;
+
+    const float invCellSize = 1.0f / gridCellSize_;
+    //target radii already include the projectile radius, so only the grid query needs it
+    int minX = FloorToInt((Min(start.x_, end.x_) - radius_) * invCellSize);
+    int maxX = FloorToInt((Max(start.x_, end.x_) + radius_) * invCellSize);
+    int minZ = FloorToInt((Min(start.z_, end.z_) - radius_) * invCellSize);
+    int maxZ = FloorToInt((Max(start.z_, end.z_) + radius_) * invCellSize);
+
+    Vector3 move = end - start;
+
+    for(int x = minX; x <= maxX; ++x)
+    {
+        for(int z = minZ; z <= maxZ; ++z)
+        {
+            unsigned bucket = GetGridBucket(x, z);
+            for(unsigned j = gridStarts_[bucket]; j < gridStarts_[bucket + 1]; ++j)
+            {
+                unsigned target = gridEntries_[j];
+                float time = SweepSphere(start, move, targetCenters_[target], targetRadii_[target]);
+                if(time < hitTime)
+                {
+                    hitTime = time;
+                    targetIndex = target;
+                }
+            }
+        }
+    }
+
+    return hitTime;
+}
+
+void ProjectileSystem::DeliverHits()
+{
+    auto* droneSwarm = GetScene()->GetComponent<DroneSwarmSystem>();
+
+    //one call per drone with the damage of all projectiles that hit it during the step
+    for(unsigned i = 0; i < targetNodes_.Size(); ++i)
+    {
+        Node* droneNode = targetNodes_[i];
+        if(targetDamage_[i] <= 0.0f || !droneNode)
+            continue;
+
+        //drones simulated natively have no script object
+        if(droneSwarm && droneSwarm->IsDrone(droneNode))
+        {
+            droneSwarm->ApplyHit(droneNode, targetDamage_[i]);
+            continue;
+        }
+
+        auto* instance = droneNode->GetComponent<ScriptInstance>();
+        if(instance)
+        {
+            droneHitMethod_.Execute(GetSubsystem<Script>(), instance->GetScriptObject(), targetDamage_[i]);
+        }
+    }
+}
+
+void ProjectileSystem::RemoveProjectile(unsigned index)
+{
+    Node* visualNode = nodes_[index];
+    if(visualNode)
+    {
+        auto* nodePool = GetScene() ? GetScene()->GetComponent<NodePool>() : nullptr;
+        if(!nodePool || !nodePool->Release(visualNode))
+            visualNode->Remove();
+    }
+
+    unsigned last = positions_.Size() - 1;
+    if(index != last)
+    {
+        positions_[index] = positions_[last];
+        previousPositions_[index] = previousPositions_[last];
+        velocities_[index] = velocities_[last];
+        ages_[index] = ages_[last];
+        nodes_[index] = nodes_[last];
+    }
+
+    positions_.Pop();
+    previousPositions_.Pop();
+    velocities_.Pop();
+    ages_.Pop();
+    nodes_.Pop();
+}
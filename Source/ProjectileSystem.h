@@ -0,0 +1,108 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef PROJECTILESYSTEM_H
+#define PROJECTILESYSTEM_H
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Scene/Component.h>
+#include <Urho3D/Scene/Node.h>
+
+#include "ScriptMethod.h"
+
+using namespace Urho3D;
+
+/// Simulates all bullets of a scene natively. Replaces the trigger body per LowLevelBullet script object: projectiles
+/// are moved in one pass per physics step and swept as spheres against the drones, found through a grid, and the
+/// floor. The hits of a step are delivered together once the pass is done.
+class ProjectileSystem : public Component
+{
+    URHO3D_OBJECT(ProjectileSystem, Component)
+
+public:
+    ProjectileSystem(Context* context);
+
+    static void RegisterObject(Context* context);
+
+    /// Fire a projectile along the rotation's forward axis.
+    void Fire(const Vector3& position, const Quaternion& rotation);
+    /// Remove all projectiles.
+    void RemoveAllProjectiles();
+    /// Return number of projectiles in flight.
+    unsigned GetProjectileCount() const { return positions_.Size(); }
+
+protected:
+    void OnSceneSet(Scene* scene) override;
+
+private:
+    void HandlePhysicsPreStep(StringHash eventType, VariantMap& eventData);
+    /// Place the visual nodes between their last two simulated positions for rendering.
+    void HandleScenePostUpdate(StringHash eventType, VariantMap& eventData);
+
+    /// Collect the drones that projectiles can hit and sort them into the grid.
+    void BuildTargetGrid();
+    /// Sweep a range of projectiles over the step and record their earliest hits, run in parallel.
+    static void SweepProjectiles(void* data, unsigned start, unsigned end);
+    /// Return the earliest hit of the swept sphere from start to end as a fraction of the sweep, or a value above 1 if none.
+    float SweepTargets(const Vector3& start, const Vector3& end, unsigned& targetIndex) const;
+    /// Apply the damage the targets took during the step.
+    void DeliverHits();
+    /// Remove projectile by index, moving the last projectile into its slot.
+    void RemoveProjectile(unsigned index);
+
+    float speed_;
+    float lifeTime_;
+    float radius_;
+    float damagePoint_;
+    int collisionLayer_;
+    int collisionMask_;
+    /// Height of the level floor, which is flat.
+    float floorHeight_;
+    int floorCollisionLayer_;
+    float gridCellSize_;
+    /// Node pool the visual node of each projectile is taken from.
+    String visualPool_;
+
+    PODVector<Vector3> positions_;
+    PODVector<Vector3> previousPositions_;
+    PODVector<Vector3> velocities_;
+    PODVector<float> ages_;
+    Vector<WeakPtr<Node> > nodes_;
+    /// Earliest hit of each projectile during the current step as a fraction of its move, above 1 if none.
+    PODVector<float> hitTimes_;
+    /// Target index of each hit, M_MAX_UNSIGNED for the floor.
+    PODVector<unsigned> hitTargets_;
+    float stepTime_;
+
+    PODVector<Vector3> targetCenters_;
+    PODVector<float> targetRadii_;
+    PODVector<float> targetDamage_;
+    Vector<WeakPtr<Node> > targetNodes_;
+    /// Start of each grid bucket in gridEntries_, with the end of the last bucket at the back.
+    PODVector<unsigned> gridStarts_;
+    /// Target indices sorted by grid bucket.
+    PODVector<unsigned> gridEntries_;
+    /// OnHit method of the script drones.
+    CachedScriptMethod droneHitMethod_;
+};
+
+#endif // PROJECTILESYSTEM_H
@@ -0,0 +1,125 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Graphics/Texture.h>
+#include <Urho3D/Scene/Scene.h>
+#include <Urho3D/UI/UIBatch.h>
+
+#include "EntityIndex.h"
+#include "PerfCounters.h"
+#include "RadarDisplay.h"
+
+RadarDisplay::RadarDisplay(Context *context) : Sprite(context)
+, trackedTag_("drone")
+, scale_(1.6f)
+, range_(40.0f)
+, clampToEdge_(true)
+, blipSize_(6)
+{
+    SetBlendMode(BLEND_ALPHA);
+}
+
+void RadarDisplay::RegisterObject(Context *context)
+{
+    context->RegisterFactory<RadarDisplay>();
+
+    URHO3D_COPY_BASE_ATTRIBUTES(Sprite);
+    URHO3D_ATTRIBUTE("Tracked Tag", trackedTag_, "drone", AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Scene To UI Scale", scale_, 1.6f, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Range", range_, 40.0f, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Clamp To Edge", clampToEdge_, true, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Blip Size", blipSize_, 6, AM_DEFAULT);
+}
+
+void RadarDisplay::GetBatches(PODVector<UIBatch>& batches, PODVector<float>& vertexData, const IntRect& currentScissor)
+{
+    if(!texture_ || !entityIndex_)
+        return;
+
+    const Vector<WeakPtr<Node> >& drones = entityIndex_->GetTaggedNodes(trackedTag_);
+    if(drones.Empty())
+        return;
+
+    PerfScope scope(GetSubsystem<PerfCounters>(), "RadarDisplay::GetBatches");
+
+    Vector3 center = centerNode_ ? centerNode_->GetWorldPosition() : Vector3::ZERO;
+    float rangeSquared = range_ * range_;
+    int halfBlip = blipSize_ / 2;
+    const Matrix3x4& transform = GetTransform();
+
+    //all blips go into a single batch, merged with any preceding batch sharing the texture
+    UIBatch batch(this, blendMode_, currentScissor, texture_, &vertexData);
+
+    for(unsigned i = 0; i < drones.Size(); ++i)
+    {
+        Node* droneNode = drones[i];
+        if(!droneNode || !droneNode->IsEnabled())
+            continue;
+
+        Vector3 relativePos = droneNode->GetWorldPosition() - center;
+        Vector2 offset(relativePos.x_, -relativePos.z_);
+
+        float distanceSquared = offset.LengthSquared();
+        if(distanceSquared > rangeSquared)
+        {
+            if(!clampToEdge_)
+                continue;
+
+            offset *= range_ / sqrtf(distanceSquared);
+        }
+
+        offset *= scale_;
+
+        batch.AddQuad(transform, (int)(hotSpot_.x_ + offset.x_) - halfBlip, (int)(hotSpot_.y_ + offset.y_) - halfBlip,
+            blipSize_, blipSize_, imageRect_.left_, imageRect_.top_, imageRect_.Width(), imageRect_.Height());
+    }
+
+    UIBatch::AddOrMerge(batch, batches);
+}
+
+void RadarDisplay::FitToParent()
+{
+    UIElement* parent = GetParent();
+    if(!parent)
+        return;
+
+    SetAlignment(HA_CENTER, VA_CENTER);
+    SetPosition(0, 0);
+    SetSize(parent->GetSize());
+    SetHotSpot(parent->GetWidth() / 2, parent->GetHeight() / 2);
+}
+
+void RadarDisplay::SetTrackedScene(Scene* scene)
+{
+    entityIndex_ = scene ? scene->GetOrCreateComponent<EntityIndex>(LOCAL) : nullptr;
+}
+
+void RadarDisplay::SetCenterNode(Node* node)
+{
+    centerNode_ = node;
+}
+
+unsigned RadarDisplay::GetDroneCount() const
+{
+    return entityIndex_ ? entityIndex_->GetTaggedCount(trackedTag_) : 0;
+}
@@ -0,0 +1,86 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef RADARDISPLAY_H
+#define RADARDISPLAY_H
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/UI/Sprite.h>
+#include <Urho3D/Scene/Node.h>
+
+namespace Urho3D
+{
+    class Scene;
+}
+
+class EntityIndex;
+
+using namespace Urho3D;
+
+/// Radar overlay that draws one blip per tracked drone. The drones are read from the scene's EntityIndex,
+/// and all blips are emitted as quads of a single UI batch. As a Sprite, the display follows the rotation
+/// of a parent radar sprite.
+class RadarDisplay : public Sprite
+{
+    URHO3D_OBJECT(RadarDisplay, Sprite)
+
+public:
+    RadarDisplay(Context* context);
+
+    static void RegisterObject(Context* context);
+
+    void GetBatches(PODVector<UIBatch>& batches, PODVector<float>& vertexData, const IntRect& currentScissor) override;
+
+    /// Size and center the display on its parent element.
+    void FitToParent();
+    /// Set the scene whose nodes with the tracked tag are shown. Creates the scene's EntityIndex if missing.
+    void SetTrackedScene(Scene* scene);
+    /// Set the node at the radar center.
+    void SetCenterNode(Node* node);
+    /// Set scene to UI scale.
+    void SetScale(float scale) { scale_ = scale; }
+    /// Set the scene distance shown up to the radar edge.
+    void SetRange(float range) { range_ = range; }
+    /// Set whether drones out of range are shown on the edge instead of hidden.
+    void SetClampToEdge(bool enable) { clampToEdge_ = enable; }
+    /// Set blip size in pixels. The blip image is the sprite texture.
+    void SetBlipSize(int size) { blipSize_ = size; }
+
+    /// Return number of tracked drones.
+    unsigned GetDroneCount() const;
+    float GetScale() const { return scale_; }
+    float GetRange() const { return range_; }
+    bool GetClampToEdge() const { return clampToEdge_; }
+    int GetBlipSize() const { return blipSize_; }
+
+private:
+    WeakPtr<EntityIndex> entityIndex_;
+    WeakPtr<Node> centerNode_;
+
+    String trackedTag_;
+    float scale_;
+    float range_;
+    bool clampToEdge_;
+    int blipSize_;
+};
+
+#endif // RADARDISPLAY_H
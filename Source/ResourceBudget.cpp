@@ -0,0 +1,317 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <cstdio>
+
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Core/CoreEvents.h>
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/Container/Sort.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/Resource/XMLFile.h>
+
+#include "ResourceBudget.h"
+
+//Seconds between budget checks
+static const float CHECK_INTERVAL = 1.0f;
+//Release passes per check, releasing a material can leave its textures unused for the next pass
+static const unsigned MAX_EVICTION_PASSES = 3;
+
+struct EvictionCandidate
+{
+    Resource* resource_;
+    unsigned useTimer_;
+};
+
+static bool CompareLeastRecentlyUsed(const EvictionCandidate& lhs, const EvictionCandidate& rhs)
+{
+    return lhs.useTimer_ > rhs.useTimer_;
+}
+
+struct Consumer
+{
+    Resource* resource_;
+    unsigned long long memoryUse_;
+};
+
+static bool CompareLargestConsumer(const Consumer& lhs, const Consumer& rhs)
+{
+    return lhs.memoryUse_ > rhs.memoryUse_;
+}
+
+static String FormatMegabytes(unsigned long long bytes)
+{
+    char text[32];
+    snprintf(text, sizeof(text), "%.2f MB", bytes / (1024.0 * 1024.0));
+    return String(text);
+}
+
+ResourceBudget::ResourceBudget(Context *context) : Object(context)
+, numEvicted_(0)
+, checkTimer_(0.0f)
+{
+    SubscribeToEvent(E_ENDFRAME, URHO3D_HANDLER(ResourceBudget, HandleEndFrame));
+}
+
+bool ResourceBudget::LoadBudgets(const String &fileName)
+{
+    XMLFile* file = GetSubsystem<ResourceCache>()->GetResource<XMLFile>(fileName);
+
+    if(!file)
+        return false;
+
+    groups_.Clear();
+
+    for(XMLElement groupElem = file->GetRoot().GetChild("group"); groupElem; groupElem = groupElem.GetNext("group"))
+    {
+        Group group;
+        group.name_ = groupElem.GetAttribute("name");
+        //budgets are given in megabytes
+        group.budget_ = (unsigned long long)(groupElem.GetFloat("budget") * 1024.0f * 1024.0f);
+
+        for(XMLElement resourceElem = groupElem.GetChild("resource"); resourceElem; resourceElem = resourceElem.GetNext("resource"))
+        {
+            GroupEntry entry;
+            entry.type_ = StringHash(resourceElem.GetAttribute("type"));
+            entry.name_ = resourceElem.GetAttribute("name");
+            group.entries_.Push(entry);
+        }
+
+        if(group.name_.Empty() || group.entries_.Empty())
+        {
+            URHO3D_LOGERROR("Invalid resource group in " + fileName);
+            continue;
+        }
+
+        groups_.Push(group);
+    }
+
+    return true;
+}
+
+void ResourceBudget::CheckBudgets()
+{
+    auto* cache = GetSubsystem<ResourceCache>();
+
+    for(unsigned i = 0; i < groups_.Size(); ++i)
+    {
+        const Group& group = groups_[i];
+        if(!group.budget_)
+            continue;
+
+        for(unsigned pass = 0; pass < MAX_EVICTION_PASSES; ++pass)
+        {
+            unsigned long long memoryUse = GetGroupMemoryUse(group.name_);
+            if(memoryUse <= group.budget_)
+                break;
+
+            //only the cache refers to these, everything in use elsewhere or kept by the preloader stays
+            PODVector<EvictionCandidate> candidates;
+            const HashMap<StringHash, ResourceGroup>& resourceGroups = cache->GetAllResources();
+            for(HashMap<StringHash, ResourceGroup>::ConstIterator j = resourceGroups.Begin(); j != resourceGroups.End(); ++j)
+            {
+                for(HashMap<StringHash, SharedPtr<Resource> >::ConstIterator k = j->second_.resources_.Begin();
+                    k != j->second_.resources_.End(); ++k)
+                {
+                    Resource* resource = k->second_;
+                    if(resource->Refs() == 1 && GetGroupIndex(j->first_, resource->GetName()) == (int)i)
+                    {
+                        EvictionCandidate candidate = { resource, resource->GetUseTimer() };
+                        candidates.Push(candidate);
+                    }
+                }
+            }
+
+            if(candidates.Empty())
+                break;
+
+            Sort(candidates.Begin(), candidates.End(), CompareLeastRecentlyUsed);
+
+            for(unsigned j = 0; j < candidates.Size() && memoryUse > group.budget_; ++j)
+            {
+                //copied, the resource is gone once released
+                Resource* resource = candidates[j].resource_;
+                StringHash type = resource->GetType();
+                String name = resource->GetName();
+                memoryUse -= Min((unsigned long long)resource->GetMemoryUse(), memoryUse);
+                URHO3D_LOGDEBUG("Releasing " + name + " over the " + group.name_ + " budget");
+                cache->ReleaseResource(type, name);
+                ++numEvicted_;
+            }
+        }
+    }
+}
+
+void ResourceBudget::SetGroupBudget(const String &group, unsigned long long budget)
+{
+    int index = FindGroup(group);
+    if(index < 0)
+    {
+        URHO3D_LOGWARNING("Unknown resource group " + group);
+        return;
+    }
+
+    groups_[index].budget_ = budget;
+}
+
+unsigned long long ResourceBudget::GetMemoryUse(const String &type) const
+{
+    return GetSubsystem<ResourceCache>()->GetMemoryUse(StringHash(type));
+}
+
+unsigned long long ResourceBudget::GetTotalMemoryUse() const
+{
+    return GetSubsystem<ResourceCache>()->GetTotalMemoryUse();
+}
+
+unsigned long long ResourceBudget::GetGroupMemoryUse(const String &group) const
+{
+    int index = FindGroup(group);
+    if(index < 0)
+        return 0;
+
+    unsigned long long memoryUse = 0;
+    const HashMap<StringHash, ResourceGroup>& resourceGroups = GetSubsystem<ResourceCache>()->GetAllResources();
+    for(HashMap<StringHash, ResourceGroup>::ConstIterator i = resourceGroups.Begin(); i != resourceGroups.End(); ++i)
+    {
+        for(HashMap<StringHash, SharedPtr<Resource> >::ConstIterator j = i->second_.resources_.Begin();
+            j != i->second_.resources_.End(); ++j)
+        {
+            if(GetGroupIndex(i->first_, j->second_->GetName()) == index)
+                memoryUse += j->second_->GetMemoryUse();
+        }
+    }
+
+    return memoryUse;
+}
+
+unsigned long long ResourceBudget::GetGroupBudget(const String &group) const
+{
+    int index = FindGroup(group);
+    return index < 0 ? 0 : groups_[index].budget_;
+}
+
+String ResourceBudget::GetReport(unsigned maxConsumers) const
+{
+    String report = "Resource memory " + FormatMegabytes(GetTotalMemoryUse()) + ", " + String(numEvicted_) + " released\n";
+
+    PODVector<Consumer> consumers;
+    const HashMap<StringHash, ResourceGroup>& resourceGroups = GetSubsystem<ResourceCache>()->GetAllResources();
+    for(HashMap<StringHash, ResourceGroup>::ConstIterator i = resourceGroups.Begin(); i != resourceGroups.End(); ++i)
+    {
+        if(i->second_.resources_.Empty())
+            continue;
+
+        const String& typeName = i->second_.resources_.Begin()->second_->GetTypeName();
+        report += "  " + typeName + ": " + String(i->second_.resources_.Size()) + " resources, " +
+            FormatMegabytes(i->second_.memoryUse_) + "\n";
+
+        for(HashMap<StringHash, SharedPtr<Resource> >::ConstIterator j = i->second_.resources_.Begin();
+            j != i->second_.resources_.End(); ++j)
+        {
+            Consumer consumer = { j->second_, j->second_->GetMemoryUse() };
+            consumers.Push(consumer);
+        }
+    }
+
+    for(unsigned i = 0; i < groups_.Size(); ++i)
+    {
+        report += "  group " + groups_[i].name_ + ": " + FormatMegabytes(GetGroupMemoryUse(groups_[i].name_)) +
+            (groups_[i].budget_ ? " of " + FormatMegabytes(groups_[i].budget_) : String(", no budget")) + "\n";
+    }
+
+    Sort(consumers.Begin(), consumers.End(), CompareLargestConsumer);
+
+    report += "Top consumers\n";
+    for(unsigned i = 0; i < consumers.Size() && i < maxConsumers; ++i)
+    {
+        Resource* resource = consumers[i].resource_;
+        report += "  " + FormatMegabytes(consumers[i].memoryUse_) + " " + resource->GetTypeName() + " " +
+            resource->GetName() + (resource->Refs() == 1 ? " (unused)" : "") + "\n";
+    }
+
+    return report;
+}
+
+String ResourceBudget::GetOverlayText() const
+{
+    String text = "Resources " + FormatMegabytes(GetTotalMemoryUse()) + "\n";
+
+    for(unsigned i = 0; i < groups_.Size(); ++i)
+    {
+        text += "  " + groups_[i].name_ + " " + FormatMegabytes(GetGroupMemoryUse(groups_[i].name_));
+        if(groups_[i].budget_)
+            text += " / " + FormatMegabytes(groups_[i].budget_);
+        text += "\n";
+    }
+
+    return text;
+}
+
+void ResourceBudget::HandleEndFrame(StringHash eventType, VariantMap &eventData)
+{
+    checkTimer_ += GetSubsystem<Time>()->GetTimeStep();
+    if(checkTimer_ < CHECK_INTERVAL)
+        return;
+
+    checkTimer_ = 0.0f;
+    CheckBudgets();
+}
+
+int ResourceBudget::GetGroupIndex(StringHash type, const String &name) const
+{
+    int typeIndex = -1;
+
+    for(unsigned i = 0; i < groups_.Size(); ++i)
+    {
+        const Vector<GroupEntry>& entries = groups_[i].entries_;
+        for(unsigned j = 0; j < entries.Size(); ++j)
+        {
+            if(entries[j].type_ != type)
+                continue;
+
+            if(entries[j].name_.Empty())
+            {
+                if(typeIndex < 0)
+                    typeIndex = i;
+            }
+            else if(entries[j].name_ == name)
+            {
+                return i;
+            }
+        }
+    }
+
+    return typeIndex;
+}
+
+int ResourceBudget::FindGroup(const String &group) const
+{
+    for(unsigned i = 0; i < groups_.Size(); ++i)
+    {
+        if(groups_[i].name_ == group)
+            return i;
+    }
+
+    return -1;
+}
@@ -0,0 +1,89 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef RESOURCEBUDGET_H
+#define RESOURCEBUDGET_H
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Core/Object.h>
+
+using namespace Urho3D;
+
+/// Accounts the memory of the resource cache per resource type and per named group of resources, and keeps the
+/// groups within their memory budgets by releasing their least recently used resources that nothing else refers to.
+class ResourceBudget : public Object
+{
+    URHO3D_OBJECT(ResourceBudget, Object)
+
+public:
+    ResourceBudget(Context* context);
+
+    /// Load the groups and their budgets from an XML file. Return true if the file was read.
+    bool LoadBudgets(const String& fileName);
+    /// Release unused resources of the groups that are over budget. Also done every second.
+    void CheckBudgets();
+    /// Set the budget of a group in bytes, 0 for no budget.
+    void SetGroupBudget(const String& group, unsigned long long budget);
+
+    /// Return the memory use of the cached resources of a type in bytes.
+    unsigned long long GetMemoryUse(const String& type) const;
+    /// Return the memory use of all cached resources in bytes.
+    unsigned long long GetTotalMemoryUse() const;
+    /// Return the memory use of a group in bytes.
+    unsigned long long GetGroupMemoryUse(const String& group) const;
+    /// Return the budget of a group in bytes, 0 if it has none.
+    unsigned long long GetGroupBudget(const String& group) const;
+    /// Return the number of resources released to keep the budgets.
+    unsigned GetNumEvicted() const { return numEvicted_; }
+    /// Return a report of the memory use per type and group, and of the largest resources.
+    String GetReport(unsigned maxConsumers) const;
+    /// Return a short summary of the groups for the perf overlay.
+    String GetOverlayText() const;
+
+private:
+    /// Resource types, or single resources when a name is given, that belong to a group.
+    struct GroupEntry
+    {
+        StringHash type_;
+        String name_;
+    };
+
+    /// Named set of resources sharing a budget.
+    struct Group
+    {
+        String name_;
+        unsigned long long budget_;
+        Vector<GroupEntry> entries_;
+    };
+
+    void HandleEndFrame(StringHash eventType, VariantMap& eventData);
+    /// Return the index of the group a resource belongs to, or -1. Entries naming the resource win over whole types.
+    int GetGroupIndex(StringHash type, const String& name) const;
+    /// Return the index of a group by name, or -1.
+    int FindGroup(const String& group) const;
+
+    Vector<Group> groups_;
+    unsigned numEvicted_;
+    float checkTimer_;
+};
+
+#endif // RESOURCEBUDGET_H
@@ -0,0 +1,222 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/Resource/ResourceEvents.h>
+#include <Urho3D/Resource/XMLFile.h>
+
+#include "ResourcePreloader.h"
+
+#ifdef __EMSCRIPTEN__
+
+#include <emscripten/emscripten.h>
+
+static void HandleDownloadLoad(unsigned handle, void* arg, const char* file)
+{
+    static_cast<ResourcePreloader*>(arg)->OnDownloadFinished(handle, String(file));
+}
+
+static void HandleDownloadError(unsigned handle, void* arg, int status)
+{
+    static_cast<ResourcePreloader*>(arg)->OnDownloadFailed(handle, status);
+}
+
+static void HandleDownloadProgress(unsigned handle, void* arg, int percent)
+{
+    static_cast<ResourcePreloader*>(arg)->OnDownloadProgress(handle, percent);
+}
+
+#endif
+
+ResourcePreloader::ResourcePreloader(Context *context) : Object(context)
+, numQueued_(0)
+, numFinished_(0)
+, numFailed_(0)
+, downloadFailed_(false)
+{
+    SubscribeToEvent(E_RESOURCEBACKGROUNDLOADED, URHO3D_HANDLER(ResourcePreloader, HandleResourceBackgroundLoaded));
+}
+
+bool ResourcePreloader::LoadManifest(const String &fileName)
+{
+    auto* cache = GetSubsystem<ResourceCache>();
+    XMLFile* file = cache->GetResource<XMLFile>(fileName);
+
+    if(!file)
+        return false;
+
+    for(XMLElement resourceElem = file->GetRoot().GetChild("resource"); resourceElem; resourceElem = resourceElem.GetNext("resource"))
+    {
+        String type = resourceElem.GetAttribute("type");
+        String name = resourceElem.GetAttribute("name");
+
+        if(type.Empty() || name.Empty())
+        {
+            URHO3D_LOGERROR("Invalid resource in manifest " + fileName);
+            continue;
+        }
+
+        QueueResource(StringHash(type), cache->SanitateResourceName(name));
+    }
+
+    return true;
+}
+
+float ResourcePreloader::GetProgress() const
+{
+    if(numQueued_ == 0)
+        return 1.0f;
+
+    return (float)numFinished_ / (float)numQueued_;
+}
+
+bool ResourcePreloader::DownloadPackage(const String &url, const String &fileName)
+{
+#ifdef __EMSCRIPTEN__
+    //the browser fetches the file between frames and the callbacks run on the main thread
+    int handle = emscripten_async_wget2(url.CString(), fileName.CString(), "GET", "", this,
+        HandleDownloadLoad, HandleDownloadError, HandleDownloadProgress);
+
+    if(handle < 0)
+        return false;
+
+    downloads_[(unsigned)handle] = 0.0f;
+    return true;
+#else
+    URHO3D_LOGERROR("Could not download " + url + ", packages are only downloaded in the web build");
+    return false;
+#endif
+}
+
+float ResourcePreloader::GetDownloadProgress() const
+{
+    if(downloads_.Empty())
+        return 1.0f;
+
+    float progress = 0.0f;
+    for(HashMap<unsigned, float>::ConstIterator i = downloads_.Begin(); i != downloads_.End(); ++i)
+        progress += i->second_;
+
+    return progress / (float)downloads_.Size();
+}
+
+void ResourcePreloader::OnDownloadFinished(unsigned handle, const String &fileName)
+{
+    downloads_.Erase(handle);
+
+    if(!GetSubsystem<ResourceCache>()->AddPackageFile(fileName))
+    {
+        downloadFailed_ = true;
+        URHO3D_LOGERROR("Could not add downloaded package " + fileName);
+        return;
+    }
+
+    downloaded_.Insert(fileName);
+}
+
+void ResourcePreloader::OnDownloadFailed(unsigned handle, int status)
+{
+    downloads_.Erase(handle);
+    downloadFailed_ = true;
+    URHO3D_LOGERROR("Package download failed with HTTP status " + String(status));
+}
+
+void ResourcePreloader::OnDownloadProgress(unsigned handle, int percent)
+{
+    HashMap<unsigned, float>::Iterator i = downloads_.Find(handle);
+    if(i != downloads_.End())
+        i->second_ = (float)percent / 100.0f;
+}
+
+void ResourcePreloader::QueueResource(StringHash type, const String &name)
+{
+    StringHash nameHash(name);
+    if(pending_.Contains(nameHash))
+        return;
+
+    //the counts start over once everything queued before has finished
+    if(pending_.Empty())
+    {
+        numQueued_ = 0;
+        numFinished_ = 0;
+    }
+
+    ++numQueued_;
+
+    auto* cache = GetSubsystem<ResourceCache>();
+
+    //loaded before
+    Resource* resource = cache->GetExistingResource(type, name);
+    if(resource)
+    {
+        resources_.Push(SharedPtr<Resource>(resource));
+        ++numFinished_;
+        return;
+    }
+
+    bool queued = cache->BackgroundLoadResource(type, name);
+
+#ifndef URHO3D_THREADING
+    //without threading the resource is loaded right away and no finish event follows
+    resource = cache->GetExistingResource(type, name);
+    queued = queued && resource;
+    if(queued)
+    {
+        resources_.Push(SharedPtr<Resource>(resource));
+        ++numFinished_;
+        return;
+    }
+#endif
+
+    //a resource that could not be queued, e.g. of an unknown type or missing without threading, never finishes loading
+    if(!queued)
+    {
+        ++numFinished_;
+        ++numFailed_;
+        URHO3D_LOGWARNING("Could not preload " + name);
+        return;
+    }
+
+    pending_.Insert(nameHash);
+}
+
+void ResourcePreloader::HandleResourceBackgroundLoaded(StringHash eventType, VariantMap &eventData)
+{
+    using namespace ResourceBackgroundLoaded;
+
+    StringHash nameHash(eventData[P_RESOURCENAME].GetString());
+    if(!pending_.Erase(nameHash))
+        return;
+
+    ++numFinished_;
+
+    if(!eventData[P_SUCCESS].GetBool())
+    {
+        ++numFailed_;
+        URHO3D_LOGWARNING("Could not preload " + eventData[P_RESOURCENAME].GetString());
+        return;
+    }
+
+    resources_.Push(SharedPtr<Resource>(static_cast<Resource*>(eventData[P_RESOURCE].GetPtr())));
+}
@@ -0,0 +1,97 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef RESOURCEPRELOADER_H
+#define RESOURCEPRELOADER_H
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Core/Object.h>
+#include <Urho3D/Container/HashMap.h>
+#include <Urho3D/Container/HashSet.h>
+#include <Urho3D/Resource/Resource.h>
+
+using namespace Urho3D;
+
+/// Streams the resources listed in manifest files through the background loader and tracks their completion,
+/// so that a scene can be started once everything it uses is in the resource cache. In the web build it also
+/// downloads the resource packages that are not preloaded with the page.
+class ResourcePreloader : public Object
+{
+    URHO3D_OBJECT(ResourcePreloader, Object)
+
+public:
+    ResourcePreloader(Context* context);
+
+    /// Queue every resource of the manifest for background loading. Return true if the manifest was read.
+    bool LoadManifest(const String& fileName);
+    /// Return the fraction of queued resources that have finished loading, 1 if nothing is queued.
+    float GetProgress() const;
+    /// Return whether all queued resources have finished loading.
+    bool IsComplete() const { return pending_.Empty(); }
+    /// Return the number of queued resources that failed to load.
+    unsigned GetNumFailed() const { return numFailed_; }
+    /// Release the references kept to the loaded resources, after which the memory budgets may release them.
+    void ReleaseResources() { resources_.Clear(); }
+    /// Download a resource package from the given URL into the file system and add it to the resource cache once
+    /// it has arrived. Only the web build downloads, return false if the download could not be started.
+    bool DownloadPackage(const String& url, const String& fileName);
+    /// Return whether a package download is in progress.
+    bool IsDownloading() const { return !downloads_.Empty(); }
+    /// Return the progress of the package downloads in progress, 1 if there are none.
+    float GetDownloadProgress() const;
+    /// Return whether a downloaded package with the given file name has been added to the resource cache.
+    bool HasPackage(const String& fileName) const { return downloaded_.Contains(fileName); }
+    /// Return whether a package download failed.
+    bool HasDownloadFailed() const { return downloadFailed_; }
+
+    /// Add a downloaded package to the resource cache, called when its download finishes.
+    void OnDownloadFinished(unsigned handle, const String& fileName);
+    /// Record a failed package download.
+    void OnDownloadFailed(unsigned handle, int status);
+    /// Update the progress of a package download.
+    void OnDownloadProgress(unsigned handle, int percent);
+
+private:
+    /// Queue one resource, or count it as finished if it is already loaded.
+    void QueueResource(StringHash type, const String& name);
+    /// Count a finished background load.
+    void HandleResourceBackgroundLoaded(StringHash eventType, VariantMap& eventData);
+
+    /// Names of the queued resources that have not finished loading.
+    HashSet<StringHash> pending_;
+    /// Number of resources queued since the last completion.
+    unsigned numQueued_;
+    /// Number of those resources that have finished loading.
+    unsigned numFinished_;
+    /// Number of resources that failed to load.
+    unsigned numFailed_;
+    /// Queued resources that have loaded, referenced until the level has started so that the memory budgets keep them.
+    Vector<SharedPtr<Resource> > resources_;
+    /// Progress of the package downloads in progress by their request handle.
+    HashMap<unsigned, float> downloads_;
+    /// File names of the packages that were downloaded and added to the resource cache.
+    HashSet<String> downloaded_;
+    /// A package download failed.
+    bool downloadFailed_;
+};
+
+#endif // RESOURCEPRELOADER_H
@@ -0,0 +1,866 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <cstddef>
+#include <cstring>
+
+#include <Urho3D/Graphics/Texture.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/Scene/Scene.h>
+#include <Urho3D/AngelScript/Script.h>
+#include <Urho3D/AngelScript/APITemplates.h>
+
+#include <AngelScript/angelscript.h>
+
+#include "DroneSwarmSystem.h"
+#include "EntityIndex.h"
+#include "GameEventChannel.h"
+#include "NodePool.h"
+#include "PlayerInput.h"
+#include "PerfCounters.h"
+#include "PrefabCache.h"
+#include "ProjectileSystem.h"
+#include "RadarDisplay.h"
+#include "ResourceBudget.h"
+#include "ScriptGC.h"
+#include "SoundVoiceManager.h"
+#include "WaveScheduler.h"
+#include "ScriptAPI.h"
+
+//All functions are registered with the generic calling convention, which is the only
+//one available when AngelScript is built with AS_MAX_PORTABILITY (web build)
+
+template <class T> static void AddRefGeneric(asIScriptGeneric* gen)
+{
+    static_cast<T*>(gen->GetObject())->AddRef();
+}
+
+template <class T> static void ReleaseRefGeneric(asIScriptGeneric* gen)
+{
+    static_cast<T*>(gen->GetObject())->ReleaseRef();
+}
+
+/// Register a RefCounted subclass as a script reference type.
+template <class T> static void RegisterRefCountedType(asIScriptEngine* engine, const char* className)
+{
+    engine->RegisterObjectType(className, 0, asOBJ_REF);
+    engine->RegisterObjectBehaviour(className, asBEHAVE_ADDREF, "void f()", asFUNCTION(AddRefGeneric<T>), asCALL_GENERIC);
+    engine->RegisterObjectBehaviour(className, asBEHAVE_RELEASE, "void f()", asFUNCTION(ReleaseRefGeneric<T>), asCALL_GENERIC);
+}
+
+//------------------------------------------ DRONE SWARM SYSTEM ------------------------------------------
+
+static void DroneSwarmSystem_SpawnDrone(asIScriptGeneric* gen)
+{
+    auto* swarm = static_cast<DroneSwarmSystem*>(gen->GetObject());
+    gen->SetReturnAddress(swarm->SpawnDrone());
+}
+
+static void DroneSwarmSystem_ApplyHit(asIScriptGeneric* gen)
+{
+    auto* swarm = static_cast<DroneSwarmSystem*>(gen->GetObject());
+    swarm->ApplyHit(static_cast<Node*>(gen->GetArgObject(0)), gen->GetArgFloat(1));
+}
+
+static void DroneSwarmSystem_RemoveAllDrones(asIScriptGeneric* gen)
+{
+    static_cast<DroneSwarmSystem*>(gen->GetObject())->RemoveAllDrones();
+}
+
+static void DroneSwarmSystem_IsDrone(asIScriptGeneric* gen)
+{
+    auto* swarm = static_cast<DroneSwarmSystem*>(gen->GetObject());
+    gen->SetReturnByte(swarm->IsDrone(static_cast<Node*>(gen->GetArgObject(0))));
+}
+
+static void DroneSwarmSystem_GetDroneCount(asIScriptGeneric* gen)
+{
+    gen->SetReturnDWord(static_cast<DroneSwarmSystem*>(gen->GetObject())->GetDroneCount());
+}
+
+static void Scene_GetDroneSwarm(asIScriptGeneric* gen)
+{
+    auto* scene = static_cast<Scene*>(gen->GetObject());
+    gen->SetReturnAddress(scene->GetComponent<DroneSwarmSystem>());
+}
+
+static void RegisterDroneSwarmSystem(asIScriptEngine* engine)
+{
+    RegisterRefCountedType<DroneSwarmSystem>(engine, "DroneSwarmSystem");
+    engine->RegisterObjectMethod("DroneSwarmSystem", "Node@+ SpawnDrone()", asFUNCTION(DroneSwarmSystem_SpawnDrone), asCALL_GENERIC);
+    engine->RegisterObjectMethod("DroneSwarmSystem", "void ApplyHit(Node@+, float)", asFUNCTION(DroneSwarmSystem_ApplyHit), asCALL_GENERIC);
+    engine->RegisterObjectMethod("DroneSwarmSystem", "void RemoveAllDrones()", asFUNCTION(DroneSwarmSystem_RemoveAllDrones), asCALL_GENERIC);
+    engine->RegisterObjectMethod("DroneSwarmSystem", "bool IsDrone(Node@+) const", asFUNCTION(DroneSwarmSystem_IsDrone), asCALL_GENERIC);
+    engine->RegisterObjectMethod("DroneSwarmSystem", "uint get_droneCount() const", asFUNCTION(DroneSwarmSystem_GetDroneCount), asCALL_GENERIC);
+
+    engine->RegisterObjectMethod("Scene", "DroneSwarmSystem@+ get_droneSwarm() const", asFUNCTION(Scene_GetDroneSwarm), asCALL_GENERIC);
+}
+
+//------------------------------------------ PROJECTILE SYSTEM ------------------------------------------
+
+static void ProjectileSystem_Fire(asIScriptGeneric* gen)
+{
+    auto* projectiles = static_cast<ProjectileSystem*>(gen->GetObject());
+    const Vector3& position = *static_cast<Vector3*>(gen->GetArgObject(0));
+    const Quaternion& rotation = *static_cast<Quaternion*>(gen->GetArgObject(1));
+    projectiles->Fire(position, rotation);
+}
+
+static void ProjectileSystem_RemoveAllProjectiles(asIScriptGeneric* gen)
+{
+    static_cast<ProjectileSystem*>(gen->GetObject())->RemoveAllProjectiles();
+}
+
+static void ProjectileSystem_GetProjectileCount(asIScriptGeneric* gen)
+{
+    gen->SetReturnDWord(static_cast<ProjectileSystem*>(gen->GetObject())->GetProjectileCount());
+}
+
+static void Scene_GetProjectiles(asIScriptGeneric* gen)
+{
+    auto* scene = static_cast<Scene*>(gen->GetObject());
+    gen->SetReturnAddress(scene->GetComponent<ProjectileSystem>());
+}
+
+static void RegisterProjectileSystem(asIScriptEngine* engine)
+{
+    RegisterRefCountedType<ProjectileSystem>(engine, "ProjectileSystem");
+    engine->RegisterObjectMethod("ProjectileSystem", "void Fire(const Vector3&in, const Quaternion&in)", asFUNCTION(ProjectileSystem_Fire), asCALL_GENERIC);
+    engine->RegisterObjectMethod("ProjectileSystem", "void RemoveAllProjectiles()", asFUNCTION(ProjectileSystem_RemoveAllProjectiles), asCALL_GENERIC);
+    engine->RegisterObjectMethod("ProjectileSystem", "uint get_projectileCount() const", asFUNCTION(ProjectileSystem_GetProjectileCount), asCALL_GENERIC);
+
+    engine->RegisterObjectMethod("Scene", "ProjectileSystem@+ get_projectiles() const", asFUNCTION(Scene_GetProjectiles), asCALL_GENERIC);
+}
+
+//------------------------------------------ WAVE SCHEDULER ------------------------------------------
+
+static void WaveScheduler_LoadSchedule(asIScriptGeneric* gen)
+{
+    auto* waves = static_cast<WaveScheduler*>(gen->GetObject());
+    gen->SetReturnByte(waves->LoadSchedule(*static_cast<String*>(gen->GetArgObject(0))));
+}
+
+static void WaveScheduler_Restart(asIScriptGeneric* gen)
+{
+    static_cast<WaveScheduler*>(gen->GetObject())->Restart();
+}
+
+static void WaveScheduler_GetElapsedTime(asIScriptGeneric* gen)
+{
+    gen->SetReturnFloat(static_cast<WaveScheduler*>(gen->GetObject())->GetElapsedTime());
+}
+
+static void WaveScheduler_GetDronesSpawned(asIScriptGeneric* gen)
+{
+    gen->SetReturnDWord(static_cast<WaveScheduler*>(gen->GetObject())->GetDronesSpawned());
+}
+
+static void Scene_GetWaveScheduler(asIScriptGeneric* gen)
+{
+    auto* scene = static_cast<Scene*>(gen->GetObject());
+    gen->SetReturnAddress(scene->GetComponent<WaveScheduler>());
+}
+
+static void RegisterWaveScheduler(asIScriptEngine* engine)
+{
+    RegisterRefCountedType<WaveScheduler>(engine, "WaveScheduler");
+    engine->RegisterObjectMethod("WaveScheduler", "bool LoadSchedule(const String&in)", asFUNCTION(WaveScheduler_LoadSchedule), asCALL_GENERIC);
+    engine->RegisterObjectMethod("WaveScheduler", "void Restart()", asFUNCTION(WaveScheduler_Restart), asCALL_GENERIC);
+    engine->RegisterObjectMethod("WaveScheduler", "float get_elapsedTime() const", asFUNCTION(WaveScheduler_GetElapsedTime), asCALL_GENERIC);
+    engine->RegisterObjectMethod("WaveScheduler", "uint get_dronesSpawned() const", asFUNCTION(WaveScheduler_GetDronesSpawned), asCALL_GENERIC);
+
+    engine->RegisterObjectMethod("Scene", "WaveScheduler@+ get_waveScheduler() const", asFUNCTION(Scene_GetWaveScheduler), asCALL_GENERIC);
+}
+
+//------------------------------------------ NODE POOL ------------------------------------------
+
+static void NodePool_LoadDefinitions(asIScriptGeneric* gen)
+{
+    auto* pool = static_cast<NodePool*>(gen->GetObject());
+    gen->SetReturnByte(pool->LoadDefinitions(*static_cast<String*>(gen->GetArgObject(0))));
+}
+
+static void NodePool_Acquire(asIScriptGeneric* gen)
+{
+    auto* pool = static_cast<NodePool*>(gen->GetObject());
+    const String& name = *static_cast<String*>(gen->GetArgObject(0));
+    const Vector3& position = *static_cast<Vector3*>(gen->GetArgObject(1));
+    const Quaternion& rotation = *static_cast<Quaternion*>(gen->GetArgObject(2));
+    gen->SetReturnAddress(pool->Acquire(name, position, rotation));
+}
+
+static void NodePool_Release(asIScriptGeneric* gen)
+{
+    auto* pool = static_cast<NodePool*>(gen->GetObject());
+    gen->SetReturnByte(pool->Release(static_cast<Node*>(gen->GetArgObject(0))));
+}
+
+static void NodePool_IsPooled(asIScriptGeneric* gen)
+{
+    auto* pool = static_cast<NodePool*>(gen->GetObject());
+    gen->SetReturnByte(pool->IsPooled(static_cast<Node*>(gen->GetArgObject(0))));
+}
+
+static void NodePool_GetFreeCount(asIScriptGeneric* gen)
+{
+    auto* pool = static_cast<NodePool*>(gen->GetObject());
+    gen->SetReturnDWord(pool->GetFreeCount(*static_cast<String*>(gen->GetArgObject(0))));
+}
+
+static void Scene_GetNodePool(asIScriptGeneric* gen)
+{
+    auto* scene = static_cast<Scene*>(gen->GetObject());
+    gen->SetReturnAddress(scene->GetComponent<NodePool>());
+}
+
+static void RegisterNodePool(asIScriptEngine* engine)
+{
+    RegisterRefCountedType<NodePool>(engine, "NodePool");
+    engine->RegisterObjectMethod("NodePool", "bool LoadDefinitions(const String&in)", asFUNCTION(NodePool_LoadDefinitions), asCALL_GENERIC);
+    engine->RegisterObjectMethod("NodePool", "Node@+ Acquire(const String&in, const Vector3&in, const Quaternion&in)", asFUNCTION(NodePool_Acquire), asCALL_GENERIC);
+    engine->RegisterObjectMethod("NodePool", "bool Release(Node@+)", asFUNCTION(NodePool_Release), asCALL_GENERIC);
+    engine->RegisterObjectMethod("NodePool", "bool IsPooled(Node@+) const", asFUNCTION(NodePool_IsPooled), asCALL_GENERIC);
+    engine->RegisterObjectMethod("NodePool", "uint GetFreeCount(const String&in) const", asFUNCTION(NodePool_GetFreeCount), asCALL_GENERIC);
+
+    engine->RegisterObjectMethod("Scene", "NodePool@+ get_nodePool() const", asFUNCTION(Scene_GetNodePool), asCALL_GENERIC);
+}
+
+//------------------------------------------ PREFAB CACHE ------------------------------------------
+
+static void Scene_SpawnPrefab(asIScriptGeneric* gen)
+{
+    auto* scene = static_cast<Scene*>(gen->GetObject());
+    const String& name = *static_cast<String*>(gen->GetArgObject(0));
+    const Vector3& position = *static_cast<Vector3*>(gen->GetArgObject(1));
+    const Quaternion& rotation = *static_cast<Quaternion*>(gen->GetArgObject(2));
+    gen->SetReturnAddress(scene->GetSubsystem<PrefabCache>()->SpawnPrefab(scene, name, position, rotation));
+}
+
+static void Scene_PreloadPrefab(asIScriptGeneric* gen)
+{
+    auto* scene = static_cast<Scene*>(gen->GetObject());
+    gen->SetReturnByte(scene->GetSubsystem<PrefabCache>()->LoadPrefab(*static_cast<String*>(gen->GetArgObject(0))));
+}
+
+static void RegisterPrefabCache(asIScriptEngine* engine)
+{
+    engine->RegisterObjectMethod("Scene", "Node@+ SpawnPrefab(const String&in, const Vector3&in, const Quaternion&in)", asFUNCTION(Scene_SpawnPrefab), asCALL_GENERIC);
+    engine->RegisterObjectMethod("Scene", "bool PreloadPrefab(const String&in)", asFUNCTION(Scene_PreloadPrefab), asCALL_GENERIC);
+}
+
+//------------------------------------------ ENTITY INDEX ------------------------------------------
+
+/// Copy a node group into a new script array, so that it can be iterated while nodes are removed.
+static CScriptArray* NodeGroupToArray(const Vector<WeakPtr<Node> >& nodes)
+{
+    PODVector<Node*> result(nodes.Size());
+    for(unsigned i = 0; i < nodes.Size(); ++i)
+    {
+        result[i] = nodes[i];
+    }
+
+    return VectorToHandleArray<Node>(result, "Array<Node@>");
+}
+
+static void EntityIndex_GetTaggedCount(asIScriptGeneric* gen)
+{
+    auto* index = static_cast<EntityIndex*>(gen->GetObject());
+    gen->SetReturnDWord(index->GetTaggedCount(*static_cast<String*>(gen->GetArgObject(0))));
+}
+
+static void EntityIndex_GetTaggedNode(asIScriptGeneric* gen)
+{
+    auto* index = static_cast<EntityIndex*>(gen->GetObject());
+    gen->SetReturnAddress(index->GetTaggedNode(*static_cast<String*>(gen->GetArgObject(0)), gen->GetArgDWord(1)));
+}
+
+static void EntityIndex_GetTaggedNodes(asIScriptGeneric* gen)
+{
+    auto* index = static_cast<EntityIndex*>(gen->GetObject());
+    gen->SetReturnAddress(NodeGroupToArray(index->GetTaggedNodes(*static_cast<String*>(gen->GetArgObject(0)))));
+}
+
+static void EntityIndex_GetScriptCount(asIScriptGeneric* gen)
+{
+    auto* index = static_cast<EntityIndex*>(gen->GetObject());
+    gen->SetReturnDWord(index->GetScriptCount(*static_cast<String*>(gen->GetArgObject(0))));
+}
+
+static void EntityIndex_GetScriptNode(asIScriptGeneric* gen)
+{
+    auto* index = static_cast<EntityIndex*>(gen->GetObject());
+    gen->SetReturnAddress(index->GetScriptNode(*static_cast<String*>(gen->GetArgObject(0)), gen->GetArgDWord(1)));
+}
+
+static void EntityIndex_GetScriptNodes(asIScriptGeneric* gen)
+{
+    auto* index = static_cast<EntityIndex*>(gen->GetObject());
+    gen->SetReturnAddress(NodeGroupToArray(index->GetScriptNodes(*static_cast<String*>(gen->GetArgObject(0)))));
+}
+
+static void EntityIndex_GetScriptedCount(asIScriptGeneric* gen)
+{
+    gen->SetReturnDWord(static_cast<EntityIndex*>(gen->GetObject())->GetScriptedCount());
+}
+
+static void EntityIndex_GetScriptedNode(asIScriptGeneric* gen)
+{
+    auto* index = static_cast<EntityIndex*>(gen->GetObject());
+    gen->SetReturnAddress(index->GetScriptedNode(gen->GetArgDWord(0)));
+}
+
+static void EntityIndex_GetScriptedNodes(asIScriptGeneric* gen)
+{
+    auto* index = static_cast<EntityIndex*>(gen->GetObject());
+    gen->SetReturnAddress(NodeGroupToArray(index->GetScriptedNodes()));
+}
+
+static void Scene_GetEntityIndex(asIScriptGeneric* gen)
+{
+    auto* scene = static_cast<Scene*>(gen->GetObject());
+    gen->SetReturnAddress(scene->GetOrCreateComponent<EntityIndex>(LOCAL));
+}
+
+static void RegisterEntityIndex(asIScriptEngine* engine)
+{
+    RegisterRefCountedType<EntityIndex>(engine, "EntityIndex");
+    engine->RegisterObjectMethod("EntityIndex", "uint GetTaggedCount(const String&in) const", asFUNCTION(EntityIndex_GetTaggedCount), asCALL_GENERIC);
+    engine->RegisterObjectMethod("EntityIndex", "Node@+ GetTaggedNode(const String&in, uint) const", asFUNCTION(EntityIndex_GetTaggedNode), asCALL_GENERIC);
+    engine->RegisterObjectMethod("EntityIndex", "Array<Node@>@ GetTaggedNodes(const String&in) const", asFUNCTION(EntityIndex_GetTaggedNodes), asCALL_GENERIC);
+    engine->RegisterObjectMethod("EntityIndex", "uint GetScriptCount(const String&in)", asFUNCTION(EntityIndex_GetScriptCount), asCALL_GENERIC);
+    engine->RegisterObjectMethod("EntityIndex", "Node@+ GetScriptNode(const String&in, uint)", asFUNCTION(EntityIndex_GetScriptNode), asCALL_GENERIC);
+    engine->RegisterObjectMethod("EntityIndex", "Array<Node@>@ GetScriptNodes(const String&in)", asFUNCTION(EntityIndex_GetScriptNodes), asCALL_GENERIC);
+    engine->RegisterObjectMethod("EntityIndex", "uint get_scriptedCount()", asFUNCTION(EntityIndex_GetScriptedCount), asCALL_GENERIC);
+    engine->RegisterObjectMethod("EntityIndex", "Node@+ GetScriptedNode(uint)", asFUNCTION(EntityIndex_GetScriptedNode), asCALL_GENERIC);
+    engine->RegisterObjectMethod("EntityIndex", "Array<Node@>@ GetScriptedNodes()", asFUNCTION(EntityIndex_GetScriptedNodes), asCALL_GENERIC);
+
+    //the index is created on first use, so that it is built before the scene is populated
+    engine->RegisterObjectMethod("Scene", "EntityIndex@+ get_entityIndex()", asFUNCTION(Scene_GetEntityIndex), asCALL_GENERIC);
+}
+
+//------------------------------------------ RADAR DISPLAY ------------------------------------------
+
+static void CreateRadarDisplay(asIScriptGeneric* gen)
+{
+    auto* parent = static_cast<UIElement*>(gen->GetArgObject(0));
+    gen->SetReturnAddress(parent ? parent->CreateChild<RadarDisplay>() : nullptr);
+}
+
+static void RadarDisplay_FitToParent(asIScriptGeneric* gen)
+{
+    static_cast<RadarDisplay*>(gen->GetObject())->FitToParent();
+}
+
+static void RadarDisplay_SetTrackedScene(asIScriptGeneric* gen)
+{
+    auto* radar = static_cast<RadarDisplay*>(gen->GetObject());
+    radar->SetTrackedScene(static_cast<Scene*>(gen->GetArgObject(0)));
+}
+
+static void RadarDisplay_SetCenterNode(asIScriptGeneric* gen)
+{
+    auto* radar = static_cast<RadarDisplay*>(gen->GetObject());
+    radar->SetCenterNode(static_cast<Node*>(gen->GetArgObject(0)));
+}
+
+static void RadarDisplay_SetTexture(asIScriptGeneric* gen)
+{
+    auto* radar = static_cast<RadarDisplay*>(gen->GetObject());
+    radar->SetTexture(static_cast<Texture*>(gen->GetArgObject(0)));
+}
+
+static void RadarDisplay_SetScale(asIScriptGeneric* gen)
+{
+    static_cast<RadarDisplay*>(gen->GetObject())->SetScale(gen->GetArgFloat(0));
+}
+
+static void RadarDisplay_SetRange(asIScriptGeneric* gen)
+{
+    static_cast<RadarDisplay*>(gen->GetObject())->SetRange(gen->GetArgFloat(0));
+}
+
+static void RadarDisplay_SetClampToEdge(asIScriptGeneric* gen)
+{
+    static_cast<RadarDisplay*>(gen->GetObject())->SetClampToEdge(gen->GetArgByte(0) != 0);
+}
+
+static void RadarDisplay_SetBlipSize(asIScriptGeneric* gen)
+{
+    static_cast<RadarDisplay*>(gen->GetObject())->SetBlipSize(gen->GetArgDWord(0));
+}
+
+static void RadarDisplay_GetDroneCount(asIScriptGeneric* gen)
+{
+    gen->SetReturnDWord(static_cast<RadarDisplay*>(gen->GetObject())->GetDroneCount());
+}
+
+static void RegisterRadarDisplay(asIScriptEngine* engine)
+{
+    RegisterRefCountedType<RadarDisplay>(engine, "RadarDisplay");
+    engine->RegisterObjectMethod("RadarDisplay", "void FitToParent()", asFUNCTION(RadarDisplay_FitToParent), asCALL_GENERIC);
+    engine->RegisterObjectMethod("RadarDisplay", "void SetTrackedScene(Scene@+)", asFUNCTION(RadarDisplay_SetTrackedScene), asCALL_GENERIC);
+    engine->RegisterObjectMethod("RadarDisplay", "void SetCenterNode(Node@+)", asFUNCTION(RadarDisplay_SetCenterNode), asCALL_GENERIC);
+    engine->RegisterObjectMethod("RadarDisplay", "void set_texture(Texture@+)", asFUNCTION(RadarDisplay_SetTexture), asCALL_GENERIC);
+    engine->RegisterObjectMethod("RadarDisplay", "void set_scale(float)", asFUNCTION(RadarDisplay_SetScale), asCALL_GENERIC);
+    engine->RegisterObjectMethod("RadarDisplay", "void set_range(float)", asFUNCTION(RadarDisplay_SetRange), asCALL_GENERIC);
+    engine->RegisterObjectMethod("RadarDisplay", "void set_clampToEdge(bool)", asFUNCTION(RadarDisplay_SetClampToEdge), asCALL_GENERIC);
+    engine->RegisterObjectMethod("RadarDisplay", "void set_blipSize(int)", asFUNCTION(RadarDisplay_SetBlipSize), asCALL_GENERIC);
+    engine->RegisterObjectMethod("RadarDisplay", "uint get_droneCount()", asFUNCTION(RadarDisplay_GetDroneCount), asCALL_GENERIC);
+
+    engine->RegisterGlobalFunction("RadarDisplay@+ CreateRadarDisplay(UIElement@+)", asFUNCTION(CreateRadarDisplay), asCALL_GENERIC);
+}
+
+//------------------------------------------ SOUND VOICE MANAGER ------------------------------------------
+
+static void Scene_PlaySound(asIScriptGeneric* gen)
+{
+    auto* scene = static_cast<Scene*>(gen->GetObject());
+    auto* voiceManager = scene->GetComponent<SoundVoiceManager>();
+    const String& name = *static_cast<String*>(gen->GetArgObject(0));
+    const Vector3& position = *static_cast<Vector3*>(gen->GetArgObject(1));
+    gen->SetReturnByte(voiceManager && voiceManager->PlaySound(name, position, gen->GetArgDWord(2)));
+}
+
+static void Scene_StopAllSounds(asIScriptGeneric* gen)
+{
+    auto* voiceManager = static_cast<Scene*>(gen->GetObject())->GetComponent<SoundVoiceManager>();
+    if(voiceManager)
+        voiceManager->StopAll();
+}
+
+static void RegisterSoundVoiceManager(asIScriptEngine* engine)
+{
+    engine->RegisterObjectMethod("Scene", "bool PlaySound(const String&in, const Vector3&in, int = 0)", asFUNCTION(Scene_PlaySound), asCALL_GENERIC);
+    engine->RegisterObjectMethod("Scene", "void StopAllSounds()", asFUNCTION(Scene_StopAllSounds), asCALL_GENERIC);
+}
+
+//------------------------------------------ PLAYER INPUT ------------------------------------------
+
+static void PlayerInput_AddLookDelta(asIScriptGeneric* gen)
+{
+    static_cast<PlayerInput*>(gen->GetObject())->AddLookDelta(gen->GetArgDWord(0), gen->GetArgDWord(1));
+}
+
+static void PlayerInput_IsFirePressed(asIScriptGeneric* gen)
+{
+    gen->SetReturnByte(static_cast<PlayerInput*>(gen->GetObject())->IsFirePressed());
+}
+
+static void PlayerInput_GetNumJoysticks(asIScriptGeneric* gen)
+{
+    gen->SetReturnDWord(static_cast<PlayerInput*>(gen->GetObject())->GetNumJoysticks());
+}
+
+static void GetPlayerInput(asIScriptGeneric* gen)
+{
+    auto* script = static_cast<Script*>(gen->GetEngine()->GetUserData());
+    gen->SetReturnAddress(script->GetSubsystem<PlayerInput>());
+}
+
+static void RegisterPlayerInput(asIScriptEngine* engine)
+{
+    RegisterRefCountedType<PlayerInput>(engine, "PlayerInput");
+    engine->RegisterObjectMethod("PlayerInput", "void AddLookDelta(int, int)", asFUNCTION(PlayerInput_AddLookDelta), asCALL_GENERIC);
+    engine->RegisterObjectMethod("PlayerInput", "bool get_firePressed() const", asFUNCTION(PlayerInput_IsFirePressed), asCALL_GENERIC);
+    engine->RegisterObjectMethod("PlayerInput", "uint get_numJoysticks() const", asFUNCTION(PlayerInput_GetNumJoysticks), asCALL_GENERIC);
+
+    engine->RegisterGlobalFunction("PlayerInput@+ get_playerInput()", asFUNCTION(GetPlayerInput), asCALL_GENERIC);
+}
+
+//------------------------------------------ PERF COUNTERS ------------------------------------------
+
+static void PerfCounters_BeginScope(asIScriptGeneric* gen)
+{
+    auto* counters = static_cast<PerfCounters*>(gen->GetObject());
+    counters->BeginScope(*static_cast<String*>(gen->GetArgObject(0)));
+}
+
+static void PerfCounters_EndScope(asIScriptGeneric* gen)
+{
+    static_cast<PerfCounters*>(gen->GetObject())->EndScope();
+}
+
+static void PerfCounters_SetOverlayVisible(asIScriptGeneric* gen)
+{
+    static_cast<PerfCounters*>(gen->GetObject())->SetOverlayVisible(gen->GetArgByte(0) != 0);
+}
+
+static void PerfCounters_IsOverlayVisible(asIScriptGeneric* gen)
+{
+    gen->SetReturnByte(static_cast<PerfCounters*>(gen->GetObject())->IsOverlayVisible());
+}
+
+static void PerfCounters_SetCsvInterval(asIScriptGeneric* gen)
+{
+    static_cast<PerfCounters*>(gen->GetObject())->SetCsvInterval(gen->GetArgFloat(0));
+}
+
+static void PerfCounters_GetCsvInterval(asIScriptGeneric* gen)
+{
+    gen->SetReturnFloat(static_cast<PerfCounters*>(gen->GetObject())->GetCsvInterval());
+}
+
+static void GetPerfCounters(asIScriptGeneric* gen)
+{
+    //the script subsystem is the engine's user data
+    auto* script = static_cast<Script*>(gen->GetEngine()->GetUserData());
+    gen->SetReturnAddress(script->GetSubsystem<PerfCounters>());
+}
+
+static void RegisterPerfCounters(asIScriptEngine* engine)
+{
+    RegisterRefCountedType<PerfCounters>(engine, "PerfCounters");
+    engine->RegisterObjectMethod("PerfCounters", "void BeginScope(const String&in)", asFUNCTION(PerfCounters_BeginScope), asCALL_GENERIC);
+    engine->RegisterObjectMethod("PerfCounters", "void EndScope()", asFUNCTION(PerfCounters_EndScope), asCALL_GENERIC);
+    engine->RegisterObjectMethod("PerfCounters", "void set_overlayVisible(bool)", asFUNCTION(PerfCounters_SetOverlayVisible), asCALL_GENERIC);
+    engine->RegisterObjectMethod("PerfCounters", "bool get_overlayVisible() const", asFUNCTION(PerfCounters_IsOverlayVisible), asCALL_GENERIC);
+    engine->RegisterObjectMethod("PerfCounters", "void set_csvInterval(float)", asFUNCTION(PerfCounters_SetCsvInterval), asCALL_GENERIC);
+    engine->RegisterObjectMethod("PerfCounters", "float get_csvInterval() const", asFUNCTION(PerfCounters_GetCsvInterval), asCALL_GENERIC);
+
+    engine->RegisterGlobalFunction("PerfCounters@+ get_perf()", asFUNCTION(GetPerfCounters), asCALL_GENERIC);
+}
+
+//------------------------------------------ RESOURCE BUDGET ------------------------------------------
+
+static void ResourceBudget_CheckBudgets(asIScriptGeneric* gen)
+{
+    static_cast<ResourceBudget*>(gen->GetObject())->CheckBudgets();
+}
+
+static void ResourceBudget_SetGroupBudget(asIScriptGeneric* gen)
+{
+    auto* budget = static_cast<ResourceBudget*>(gen->GetObject());
+    budget->SetGroupBudget(*static_cast<String*>(gen->GetArgObject(0)), gen->GetArgQWord(1));
+}
+
+static void ResourceBudget_GetMemoryUse(asIScriptGeneric* gen)
+{
+    auto* budget = static_cast<ResourceBudget*>(gen->GetObject());
+    gen->SetReturnQWord(budget->GetMemoryUse(*static_cast<String*>(gen->GetArgObject(0))));
+}
+
+static void ResourceBudget_GetTotalMemoryUse(asIScriptGeneric* gen)
+{
+    gen->SetReturnQWord(static_cast<ResourceBudget*>(gen->GetObject())->GetTotalMemoryUse());
+}
+
+static void ResourceBudget_GetGroupMemoryUse(asIScriptGeneric* gen)
+{
+    auto* budget = static_cast<ResourceBudget*>(gen->GetObject());
+    gen->SetReturnQWord(budget->GetGroupMemoryUse(*static_cast<String*>(gen->GetArgObject(0))));
+}
+
+static void ResourceBudget_GetGroupBudget(asIScriptGeneric* gen)
+{
+    auto* budget = static_cast<ResourceBudget*>(gen->GetObject());
+    gen->SetReturnQWord(budget->GetGroupBudget(*static_cast<String*>(gen->GetArgObject(0))));
+}
+
+static void ResourceBudget_GetNumEvicted(asIScriptGeneric* gen)
+{
+    gen->SetReturnDWord(static_cast<ResourceBudget*>(gen->GetObject())->GetNumEvicted());
+}
+
+static void ResourceBudget_GetReport(asIScriptGeneric* gen)
+{
+    String report = static_cast<ResourceBudget*>(gen->GetObject())->GetReport(gen->GetArgDWord(0));
+    gen->SetReturnObject(&report);
+}
+
+static void GetResourceBudget(asIScriptGeneric* gen)
+{
+    auto* script = static_cast<Script*>(gen->GetEngine()->GetUserData());
+    gen->SetReturnAddress(script->GetSubsystem<ResourceBudget>());
+}
+
+static void RegisterResourceBudget(asIScriptEngine* engine)
+{
+    RegisterRefCountedType<ResourceBudget>(engine, "ResourceBudget");
+    engine->RegisterObjectMethod("ResourceBudget", "void CheckBudgets()", asFUNCTION(ResourceBudget_CheckBudgets), asCALL_GENERIC);
+    engine->RegisterObjectMethod("ResourceBudget", "void SetGroupBudget(const String&in, uint64)", asFUNCTION(ResourceBudget_SetGroupBudget), asCALL_GENERIC);
+    engine->RegisterObjectMethod("ResourceBudget", "uint64 GetMemoryUse(const String&in) const", asFUNCTION(ResourceBudget_GetMemoryUse), asCALL_GENERIC);
+    engine->RegisterObjectMethod("ResourceBudget", "uint64 get_totalMemoryUse() const", asFUNCTION(ResourceBudget_GetTotalMemoryUse), asCALL_GENERIC);
+    engine->RegisterObjectMethod("ResourceBudget", "uint64 GetGroupMemoryUse(const String&in) const", asFUNCTION(ResourceBudget_GetGroupMemoryUse), asCALL_GENERIC);
+    engine->RegisterObjectMethod("ResourceBudget", "uint64 GetGroupBudget(const String&in) const", asFUNCTION(ResourceBudget_GetGroupBudget), asCALL_GENERIC);
+    engine->RegisterObjectMethod("ResourceBudget", "uint get_numEvicted() const", asFUNCTION(ResourceBudget_GetNumEvicted), asCALL_GENERIC);
+    engine->RegisterObjectMethod("ResourceBudget", "String GetReport(uint) const", asFUNCTION(ResourceBudget_GetReport), asCALL_GENERIC);
+
+    engine->RegisterGlobalFunction("ResourceBudget@+ get_resourceBudget()", asFUNCTION(GetResourceBudget), asCALL_GENERIC);
+}
+
+//------------------------------------------ SCRIPT GC ------------------------------------------
+
+static void ScriptGC_SetFrameBudget(asIScriptGeneric* gen)
+{
+    static_cast<ScriptGC*>(gen->GetObject())->SetFrameBudget(gen->GetArgFloat(0));
+}
+
+static void ScriptGC_GetFrameBudget(asIScriptGeneric* gen)
+{
+    gen->SetReturnFloat(static_cast<ScriptGC*>(gen->GetObject())->GetFrameBudget());
+}
+
+static void ScriptGC_SetIdleBudget(asIScriptGeneric* gen)
+{
+    static_cast<ScriptGC*>(gen->GetObject())->SetIdleBudget(gen->GetArgFloat(0));
+}
+
+static void ScriptGC_GetIdleBudget(asIScriptGeneric* gen)
+{
+    gen->SetReturnFloat(static_cast<ScriptGC*>(gen->GetObject())->GetIdleBudget());
+}
+
+static void ScriptGC_SetIdle(asIScriptGeneric* gen)
+{
+    static_cast<ScriptGC*>(gen->GetObject())->SetIdle(gen->GetArgByte(0) != 0);
+}
+
+static void ScriptGC_IsIdle(asIScriptGeneric* gen)
+{
+    gen->SetReturnByte(static_cast<ScriptGC*>(gen->GetObject())->IsIdle());
+}
+
+static void ScriptGC_GetNumObjects(asIScriptGeneric* gen)
+{
+    gen->SetReturnDWord(static_cast<ScriptGC*>(gen->GetObject())->GetNumObjects());
+}
+
+static void ScriptGC_GetNumCycles(asIScriptGeneric* gen)
+{
+    gen->SetReturnDWord(static_cast<ScriptGC*>(gen->GetObject())->GetNumCycles());
+}
+
+static void ScriptGC_GetLastCycleTime(asIScriptGeneric* gen)
+{
+    gen->SetReturnFloat(static_cast<ScriptGC*>(gen->GetObject())->GetLastCycleTime());
+}
+
+static void ScriptGC_GetMaxFrameTime(asIScriptGeneric* gen)
+{
+    gen->SetReturnFloat(static_cast<ScriptGC*>(gen->GetObject())->GetMaxFrameTime());
+}
+
+static void ScriptGC_GetClassCount(asIScriptGeneric* gen)
+{
+    auto* gc = static_cast<ScriptGC*>(gen->GetObject());
+    gen->SetReturnDWord(gc->GetClassCount(*static_cast<String*>(gen->GetArgObject(0))));
+}
+
+static void ScriptGC_GetLeakSuspects(asIScriptGeneric* gen)
+{
+    Vector<String> suspects = static_cast<ScriptGC*>(gen->GetObject())->GetLeakSuspects();
+    gen->SetReturnAddress(VectorToArray<String>(suspects, "Array<String>"));
+}
+
+static void ScriptGC_GetReport(asIScriptGeneric* gen)
+{
+    String report = static_cast<ScriptGC*>(gen->GetObject())->GetReport();
+    gen->SetReturnObject(&report);
+}
+
+static void GetScriptGC(asIScriptGeneric* gen)
+{
+    auto* script = static_cast<Script*>(gen->GetEngine()->GetUserData());
+    gen->SetReturnAddress(script->GetSubsystem<ScriptGC>());
+}
+
+static void RegisterScriptGC(asIScriptEngine* engine)
+{
+    RegisterRefCountedType<ScriptGC>(engine, "ScriptGC");
+    engine->RegisterObjectMethod("ScriptGC", "void set_frameBudget(float)", asFUNCTION(ScriptGC_SetFrameBudget), asCALL_GENERIC);
+    engine->RegisterObjectMethod("ScriptGC", "float get_frameBudget() const", asFUNCTION(ScriptGC_GetFrameBudget), asCALL_GENERIC);
+    engine->RegisterObjectMethod("ScriptGC", "void set_idleBudget(float)", asFUNCTION(ScriptGC_SetIdleBudget), asCALL_GENERIC);
+    engine->RegisterObjectMethod("ScriptGC", "float get_idleBudget() const", asFUNCTION(ScriptGC_GetIdleBudget), asCALL_GENERIC);
+    engine->RegisterObjectMethod("ScriptGC", "void set_idle(bool)", asFUNCTION(ScriptGC_SetIdle), asCALL_GENERIC);
+    engine->RegisterObjectMethod("ScriptGC", "bool get_idle() const", asFUNCTION(ScriptGC_IsIdle), asCALL_GENERIC);
+    engine->RegisterObjectMethod("ScriptGC", "uint get_numObjects() const", asFUNCTION(ScriptGC_GetNumObjects), asCALL_GENERIC);
+    engine->RegisterObjectMethod("ScriptGC", "uint get_numCycles() const", asFUNCTION(ScriptGC_GetNumCycles), asCALL_GENERIC);
+    engine->RegisterObjectMethod("ScriptGC", "float get_lastCycleTime() const", asFUNCTION(ScriptGC_GetLastCycleTime), asCALL_GENERIC);
+    engine->RegisterObjectMethod("ScriptGC", "float get_maxFrameTime() const", asFUNCTION(ScriptGC_GetMaxFrameTime), asCALL_GENERIC);
+    engine->RegisterObjectMethod("ScriptGC", "uint GetClassCount(const String&in) const", asFUNCTION(ScriptGC_GetClassCount), asCALL_GENERIC);
+    engine->RegisterObjectMethod("ScriptGC", "Array<String>@ GetLeakSuspects() const", asFUNCTION(ScriptGC_GetLeakSuspects), asCALL_GENERIC);
+    engine->RegisterObjectMethod("ScriptGC", "String GetReport() const", asFUNCTION(ScriptGC_GetReport), asCALL_GENERIC);
+
+    engine->RegisterGlobalFunction("ScriptGC@+ get_scriptGC()", asFUNCTION(GetScriptGC), asCALL_GENERIC);
+}
+
+//------------------------------------------ GAME EVENT CHANNEL ------------------------------------------
+
+template <class T> static void ConstructGameEvent(asIScriptGeneric* gen)
+{
+    memset(gen->GetObject(), 0, sizeof(T));
+}
+
+static void ConstructPlayerHealthUpdateEvent(asIScriptGeneric* gen)
+{
+    auto* event = static_cast<PlayerHealthUpdate::Data*>(gen->GetObject());
+    event->currentHealthFraction_ = gen->GetArgFloat(0);
+}
+
+static void ConstructPlayerDestroyedEvent(asIScriptGeneric* gen)
+{
+    auto* event = static_cast<PlayerDestroyed::Data*>(gen->GetObject());
+    event->camPosition_ = *static_cast<Vector3*>(gen->GetArgObject(0));
+    event->camRotation_ = *static_cast<Quaternion*>(gen->GetArgObject(1));
+    event->playerPosition_ = *static_cast<Vector3*>(gen->GetArgObject(2));
+    event->playerRotation_ = *static_cast<Quaternion*>(gen->GetArgObject(3));
+}
+
+static void ConstructDroneDestroyedEvent(asIScriptGeneric* gen)
+{
+    auto* event = static_cast<DroneDestroyed::Data*>(gen->GetObject());
+    event->dronePoint_ = gen->GetArgDWord(0);
+}
+
+static void ConstructPlayerRotationEvent(asIScriptGeneric* gen)
+{
+    auto* event = static_cast<PlayerRotation::Data*>(gen->GetObject());
+    event->dx_ = gen->GetArgDWord(0);
+    event->dy_ = gen->GetArgDWord(1);
+}
+
+/// Register a game event payload as a script value type with a zeroing default constructor.
+template <class T> static void RegisterGameEventType(asIScriptEngine* engine, const char* typeName)
+{
+    engine->RegisterObjectType(typeName, sizeof(T), asOBJ_VALUE | asOBJ_POD | asGetTypeTraits<T>());
+    engine->RegisterObjectBehaviour(typeName, asBEHAVE_CONSTRUCT, "void f()", asFUNCTION(ConstructGameEvent<T>), asCALL_GENERIC);
+}
+
+template <class T> static void GameEventChannel_Post(asIScriptGeneric* gen)
+{
+    static_cast<GameEventChannel*>(gen->GetObject())->Post(*static_cast<T*>(gen->GetArgObject(0)));
+}
+
+static void GameEventChannel_PostEmpty(asIScriptGeneric* gen)
+{
+    gen->SetReturnByte(static_cast<GameEventChannel*>(gen->GetObject())->Post((GameEventId)gen->GetArgDWord(0)));
+}
+
+/// Return the script object whose method is calling, or null if called from a global function.
+static asIScriptObject* GetCallingScriptObject()
+{
+    asIScriptContext* context = asGetActiveContext();
+    if(!context || !(context->GetThisTypeId() & asTYPEID_SCRIPTOBJECT))
+        return nullptr;
+
+    return static_cast<asIScriptObject*>(context->GetThisPointer());
+}
+
+static void GameEventChannel_Subscribe(asIScriptGeneric* gen)
+{
+    auto* channel = static_cast<GameEventChannel*>(gen->GetObject());
+    asIScriptObject* object = GetCallingScriptObject();
+    if(!object)
+    {
+        URHO3D_LOGERROR("Game events can only be subscribed to from a script class method");
+        gen->SetReturnByte(false);
+        return;
+    }
+
+    const String& handlerName = *static_cast<String*>(gen->GetArgObject(1));
+    gen->SetReturnByte(channel->SubscribeScript((GameEventId)gen->GetArgDWord(0), object, handlerName));
+}
+
+static void GameEventChannel_Unsubscribe(asIScriptGeneric* gen)
+{
+    auto* channel = static_cast<GameEventChannel*>(gen->GetObject());
+    asIScriptObject* object = GetCallingScriptObject();
+    if(object)
+        channel->UnsubscribeScript((GameEventId)gen->GetArgDWord(0), object);
+}
+
+static void GameEventChannel_UnsubscribeAll(asIScriptGeneric* gen)
+{
+    auto* channel = static_cast<GameEventChannel*>(gen->GetObject());
+    asIScriptObject* object = GetCallingScriptObject();
+    if(object)
+        channel->UnsubscribeScript(object);
+}
+
+static void GetGameEventChannel(asIScriptGeneric* gen)
+{
+    auto* script = static_cast<Script*>(gen->GetEngine()->GetUserData());
+    gen->SetReturnAddress(script->GetSubsystem<GameEventChannel>());
+}
+
+static void RegisterGameEventChannel(asIScriptEngine* engine)
+{
+    engine->RegisterEnum("GameEvent");
+    engine->RegisterEnumValue("GameEvent", "GE_PLAYERHIT", GE_PLAYERHIT);
+    engine->RegisterEnumValue("GameEvent", "GE_PLAYERHEALTHUPDATE", GE_PLAYERHEALTHUPDATE);
+    engine->RegisterEnumValue("GameEvent", "GE_PLAYERDESTROYED", GE_PLAYERDESTROYED);
+    engine->RegisterEnumValue("GameEvent", "GE_DRONEDESTROYED", GE_DRONEDESTROYED);
+    engine->RegisterEnumValue("GameEvent", "GE_PLAYERROTATION", GE_PLAYERROTATION);
+    engine->RegisterEnumValue("GameEvent", "GE_COUNTFINISHED", GE_COUNTFINISHED);
+    engine->RegisterEnumValue("GameEvent", "GE_ACTIVATEWEAPON", GE_ACTIVATEWEAPON);
+
+    RegisterGameEventType<PlayerHealthUpdate::Data>(engine, "PlayerHealthUpdateEvent");
+    engine->RegisterObjectBehaviour("PlayerHealthUpdateEvent", asBEHAVE_CONSTRUCT, "void f(float)", asFUNCTION(ConstructPlayerHealthUpdateEvent), asCALL_GENERIC);
+    engine->RegisterObjectProperty("PlayerHealthUpdateEvent", "float currentHealthFraction", offsetof(PlayerHealthUpdate::Data, currentHealthFraction_));
+
+    RegisterGameEventType<PlayerDestroyed::Data>(engine, "PlayerDestroyedEvent");
+    engine->RegisterObjectBehaviour("PlayerDestroyedEvent", asBEHAVE_CONSTRUCT, "void f(const Vector3&in, const Quaternion&in, const Vector3&in, const Quaternion&in)", asFUNCTION(ConstructPlayerDestroyedEvent), asCALL_GENERIC);
+    engine->RegisterObjectProperty("PlayerDestroyedEvent", "Vector3 camPosition", offsetof(PlayerDestroyed::Data, camPosition_));
+    engine->RegisterObjectProperty("PlayerDestroyedEvent", "Quaternion camRotation", offsetof(PlayerDestroyed::Data, camRotation_));
+    engine->RegisterObjectProperty("PlayerDestroyedEvent", "Vector3 playerPosition", offsetof(PlayerDestroyed::Data, playerPosition_));
+    engine->RegisterObjectProperty("PlayerDestroyedEvent", "Quaternion playerRotation", offsetof(PlayerDestroyed::Data, playerRotation_));
+
+    RegisterGameEventType<DroneDestroyed::Data>(engine, "DroneDestroyedEvent");
+    engine->RegisterObjectBehaviour("DroneDestroyedEvent", asBEHAVE_CONSTRUCT, "void f(int)", asFUNCTION(ConstructDroneDestroyedEvent), asCALL_GENERIC);
+    engine->RegisterObjectProperty("DroneDestroyedEvent", "int dronePoint", offsetof(DroneDestroyed::Data, dronePoint_));
+
+    RegisterGameEventType<PlayerRotation::Data>(engine, "PlayerRotationEvent");
+    engine->RegisterObjectBehaviour("PlayerRotationEvent", asBEHAVE_CONSTRUCT, "void f(int, int)", asFUNCTION(ConstructPlayerRotationEvent), asCALL_GENERIC);
+    engine->RegisterObjectProperty("PlayerRotationEvent", "int dx", offsetof(PlayerRotation::Data, dx_));
+    engine->RegisterObjectProperty("PlayerRotationEvent", "int dy", offsetof(PlayerRotation::Data, dy_));
+
+    RegisterRefCountedType<GameEventChannel>(engine, "GameEventChannel");
+    engine->RegisterObjectMethod("GameEventChannel", "bool Post(GameEvent)", asFUNCTION(GameEventChannel_PostEmpty), asCALL_GENERIC);
+    engine->RegisterObjectMethod("GameEventChannel", "void Post(const PlayerHealthUpdateEvent&in)", asFUNCTION(GameEventChannel_Post<PlayerHealthUpdate::Data>), asCALL_GENERIC);
+    engine->RegisterObjectMethod("GameEventChannel", "void Post(const PlayerDestroyedEvent&in)", asFUNCTION(GameEventChannel_Post<PlayerDestroyed::Data>), asCALL_GENERIC);
+    engine->RegisterObjectMethod("GameEventChannel", "void Post(const DroneDestroyedEvent&in)", asFUNCTION(GameEventChannel_Post<DroneDestroyed::Data>), asCALL_GENERIC);
+    engine->RegisterObjectMethod("GameEventChannel", "void Post(const PlayerRotationEvent&in)", asFUNCTION(GameEventChannel_Post<PlayerRotation::Data>), asCALL_GENERIC);
+    engine->RegisterObjectMethod("GameEventChannel", "bool Subscribe(GameEvent, const String&in)", asFUNCTION(GameEventChannel_Subscribe), asCALL_GENERIC);
+    engine->RegisterObjectMethod("GameEventChannel", "void Unsubscribe(GameEvent)", asFUNCTION(GameEventChannel_Unsubscribe), asCALL_GENERIC);
+    engine->RegisterObjectMethod("GameEventChannel", "void UnsubscribeAll()", asFUNCTION(GameEventChannel_UnsubscribeAll), asCALL_GENERIC);
+
+    engine->RegisterGlobalFunction("GameEventChannel@+ get_gameEvents()", asFUNCTION(GetGameEventChannel), asCALL_GENERIC);
+}
+
+void RegisterGameScriptAPI(Context* context)
+{
+    asIScriptEngine* engine = context->GetSubsystem<Script>()->GetScriptEngine();
+
+    RegisterDroneSwarmSystem(engine);
+    RegisterNodePool(engine);
+    RegisterProjectileSystem(engine);
+    RegisterWaveScheduler(engine);
+    RegisterPrefabCache(engine);
+    RegisterEntityIndex(engine);
+    RegisterRadarDisplay(engine);
+    RegisterPerfCounters(engine);
+    RegisterResourceBudget(engine);
+    RegisterScriptGC(engine);
+    RegisterSoundVoiceManager(engine);
+    RegisterGameEventChannel(engine);
+    RegisterPlayerInput(engine);
+}
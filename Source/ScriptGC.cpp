@@ -0,0 +1,191 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <cstdio>
+
+#include <Urho3D/AngelScript/Script.h>
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Core/CoreEvents.h>
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/IO/Log.h>
+
+#include <AngelScript/angelscript.h>
+
+#include "PerfCounters.h"
+#include "ScriptGC.h"
+
+//Seconds between samples of the object counts per class
+static const float SAMPLE_INTERVAL = 2.0f;
+//Number of consecutive samples with a growing count that make a class a leak suspect
+static const unsigned LEAK_SAMPLES = 5;
+
+ScriptGC::ScriptGC(Context *context) : Object(context)
+, frameBudget_(0.25f)
+, idleBudget_(4.0f)
+, idle_(false)
+, numCycles_(0)
+, cycleTime_(0.0f)
+, lastCycleTime_(0.0f)
+, maxFrameTime_(0.0f)
+, sampleTimer_(0.0f)
+{
+    auto* script = GetSubsystem<Script>();
+    if(!script)
+    {
+        URHO3D_LOGWARNING("ScriptGC created without the script subsystem, the script engine collects on its own");
+        return;
+    }
+
+    //left to the engine, a collection step runs whenever a garbage collected object is created, in any frame
+    script->GetScriptEngine()->SetEngineProperty(asEP_AUTO_GARBAGE_COLLECT, false);
+
+    SubscribeToEvent(E_ENDFRAME, URHO3D_HANDLER(ScriptGC, HandleEndFrame));
+}
+
+unsigned ScriptGC::GetNumObjects() const
+{
+    asUINT currentSize = 0;
+    GetSubsystem<Script>()->GetScriptEngine()->GetGCStatistics(&currentSize);
+    return currentSize;
+}
+
+unsigned ScriptGC::GetClassCount(const String &className) const
+{
+    HashMap<StringHash, ClassStats>::ConstIterator i = classes_.Find(StringHash(className));
+    return i != classes_.End() ? i->second_.count_ : 0;
+}
+
+Vector<String> ScriptGC::GetLeakSuspects() const
+{
+    Vector<String> suspects;
+    for(HashMap<StringHash, ClassStats>::ConstIterator i = classes_.Begin(); i != classes_.End(); ++i)
+    {
+        if(i->second_.growth_ >= LEAK_SAMPLES)
+            suspects.Push(i->second_.name_);
+    }
+
+    return suspects;
+}
+
+String ScriptGC::GetReport() const
+{
+    char line[128];
+    snprintf(line, sizeof(line), "Script GC: %u objects, %u cycles, last cycle %.3f ms, max frame %.3f ms\n", GetNumObjects(),
+        numCycles_, lastCycleTime_, maxFrameTime_);
+    String report(line);
+
+    for(HashMap<StringHash, ClassStats>::ConstIterator i = classes_.Begin(); i != classes_.End(); ++i)
+    {
+        const ClassStats& stats = i->second_;
+        //script type names are unbounded, only the counts go through the fixed size buffer
+        report += "  " + stats.name_;
+        if(stats.name_.Length() < 24)
+            report += String(' ', 24 - stats.name_.Length());
+
+        snprintf(line, sizeof(line), " %7u (peak %u)%s\n", stats.count_, stats.peak_,
+            stats.growth_ >= LEAK_SAMPLES ? " leak suspect" : "");
+        report += line;
+    }
+
+    return report;
+}
+
+void ScriptGC::HandleEndFrame(StringHash eventType, VariantMap &eventData)
+{
+    PerfScope scope(GetSubsystem<PerfCounters>(), "ScriptGC::Collect");
+
+    asIScriptEngine* engine = GetSubsystem<Script>()->GetScriptEngine();
+    long long budget = (long long)((idle_ ? idleBudget_ : frameBudget_) * 1000.0f);
+
+    HiresTimer timer;
+    bool cycleFinished = false;
+
+    //at least one step per frame so that collection never stops, then steps until the budget is spent or the
+    //cycle finishes, the next cycle starts in the next frame
+    do
+    {
+        int result = engine->GarbageCollect(asGC_ONE_STEP);
+        if(result <= 0)
+        {
+            cycleFinished = result == 0;
+            break;
+        }
+    }
+    while(timer.GetUSec(false) < budget);
+
+    float frameTime = timer.GetUSec(false) / 1000.0f;
+    maxFrameTime_ = Max(maxFrameTime_, frameTime);
+    cycleTime_ += frameTime;
+
+    if(cycleFinished)
+    {
+        ++numCycles_;
+        lastCycleTime_ = cycleTime_;
+        cycleTime_ = 0.0f;
+    }
+
+    //counted after a finished cycle, when the counts hold no garbage that is only waiting to be found
+    sampleTimer_ += GetSubsystem<Time>()->GetTimeStep();
+    if(cycleFinished && sampleTimer_ >= SAMPLE_INTERVAL)
+    {
+        sampleTimer_ = 0.0f;
+        SampleClasses();
+    }
+}
+
+void ScriptGC::SampleClasses()
+{
+    asIScriptEngine* engine = GetSubsystem<Script>()->GetScriptEngine();
+
+    HashMap<StringHash, unsigned> counts;
+    asITypeInfo* type = nullptr;
+    for(asUINT i = 0; engine->GetObjectInGC(i, nullptr, nullptr, &type) >= 0; ++i)
+    {
+        if(!type)
+            continue;
+
+        StringHash nameHash(type->GetName());
+        ClassStats& stats = classes_[nameHash];
+        if(stats.name_.Empty())
+            stats.name_ = type->GetName();
+
+        ++counts[nameHash];
+    }
+
+    for(HashMap<StringHash, ClassStats>::Iterator i = classes_.Begin(); i != classes_.End(); ++i)
+    {
+        ClassStats& stats = i->second_;
+        HashMap<StringHash, unsigned>::ConstIterator count = counts.Find(i->first_);
+        unsigned newCount = count != counts.End() ? count->second_ : 0;
+
+        stats.growth_ = newCount > stats.count_ ? stats.growth_ + 1 : 0;
+        stats.count_ = newCount;
+        stats.peak_ = Max(stats.peak_, newCount);
+    }
+
+    Vector<String> suspects = GetLeakSuspects();
+    for(unsigned i = 0; i < suspects.Size(); ++i)
+    {
+        if(classes_[StringHash(suspects[i])].growth_ == LEAK_SAMPLES)
+            URHO3D_LOGWARNING("Script class " + suspects[i] + " keeps growing across collections, possible leak");
+    }
+}
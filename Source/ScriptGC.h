@@ -0,0 +1,101 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef SCRIPTGC_H
+#define SCRIPTGC_H
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Core/Object.h>
+#include <Urho3D/Container/HashMap.h>
+
+using namespace Urho3D;
+
+/// Runs the AngelScript garbage collector in incremental steps at the end of each frame, within a time budget
+/// that is larger while the level is idle (paused, counting down or over), instead of letting the script engine
+/// collect whenever objects are created. Keeps collection times and per script class object counts, and flags
+/// the classes whose objects keep growing across collection cycles as leak suspects.
+class ScriptGC : public Object
+{
+    URHO3D_OBJECT(ScriptGC, Object)
+
+public:
+    /// Construct after the script subsystem, whose automatic collection is turned off.
+    ScriptGC(Context* context);
+
+    /// Set the collection time per gameplay frame in milliseconds.
+    void SetFrameBudget(float budget) { frameBudget_ = Max(budget, 0.0f); }
+    /// Set the collection time per idle frame in milliseconds.
+    void SetIdleBudget(float budget) { idleBudget_ = Max(budget, 0.0f); }
+    /// Set whether the level is idle, so that frames can spend the idle budget.
+    void SetIdle(bool enable) { idle_ = enable; }
+
+    /// Return the collection time per gameplay frame in milliseconds.
+    float GetFrameBudget() const { return frameBudget_; }
+    /// Return the collection time per idle frame in milliseconds.
+    float GetIdleBudget() const { return idleBudget_; }
+    /// Return whether the level is idle.
+    bool IsIdle() const { return idle_; }
+    /// Return the number of objects the collector tracks.
+    unsigned GetNumObjects() const;
+    /// Return the number of completed collection cycles.
+    unsigned GetNumCycles() const { return numCycles_; }
+    /// Return the collection time of the last completed cycle in milliseconds, summed over its steps.
+    float GetLastCycleTime() const { return lastCycleTime_; }
+    /// Return the longest collection time spent in one frame in milliseconds.
+    float GetMaxFrameTime() const { return maxFrameTime_; }
+    /// Return the number of tracked objects of a script class at the last sample.
+    unsigned GetClassCount(const String& className) const;
+    /// Return the names of the classes whose object counts grew over the last samples.
+    Vector<String> GetLeakSuspects() const;
+    /// Return a report of the collection times and the object counts per class.
+    String GetReport() const;
+
+private:
+    /// Object counts of one script class.
+    struct ClassStats
+    {
+        ClassStats() : count_(0), peak_(0), growth_(0) {}
+
+        String name_;
+        unsigned count_;
+        unsigned peak_;
+        /// Number of consecutive samples the count has grown at.
+        unsigned growth_;
+    };
+
+    void HandleEndFrame(StringHash eventType, VariantMap& eventData);
+    /// Count the tracked objects per class.
+    void SampleClasses();
+
+    HashMap<StringHash, ClassStats> classes_;
+    float frameBudget_;
+    float idleBudget_;
+    bool idle_;
+    unsigned numCycles_;
+    /// Collection time of the cycle in progress and of the last completed one.
+    float cycleTime_;
+    float lastCycleTime_;
+    float maxFrameTime_;
+    float sampleTimer_;
+};
+
+#endif // SCRIPTGC_H
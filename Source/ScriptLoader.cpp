@@ -0,0 +1,200 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/IO/File.h>
+#include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/AngelScript/ScriptFile.h>
+
+#include "ScriptLoader.h"
+
+//Resource directory of the game scripts
+static const String SCRIPT_DIR("Scripts/");
+
+/// Collect the file names of the scripts that a script source includes.
+static void GetIncludes(const String& source, Vector<String>& includes)
+{
+    Vector<String> lines = source.Split('\n');
+    for(unsigned i = 0; i < lines.Size(); ++i)
+    {
+        String line = lines[i].Trimmed();
+        if(!line.StartsWith("#include"))
+            continue;
+
+        unsigned start = line.Find('"');
+        unsigned end = line.Find('"', start + 1);
+        if(start != String::NPOS && end != String::NPOS)
+        {
+            includes.Push(GetFileNameAndExtension(line.Substring(start + 1, end - start - 1)));
+        }
+    }
+}
+
+ScriptLoader::ScriptLoader(Context *context) : Object(context)
+{
+
+}
+
+bool ScriptLoader::Preload(const String &scriptName, bool background)
+{
+    auto* cache = GetSubsystem<ResourceCache>();
+
+    if(cache->GetExistingResource<ScriptFile>(scriptName))
+        return false;
+
+    if(LoadByteCode(scriptName))
+        return true;
+
+    if(background)
+    {
+        //the files are read on a worker thread, which leaves only the compile on the main thread
+        cache->BackgroundLoadResource<ScriptFile>(scriptName);
+    }
+    else
+    {
+        cache->GetResource<ScriptFile>(scriptName);
+    }
+
+    return false;
+}
+
+bool ScriptLoader::LoadByteCode(const String &scriptName)
+{
+    auto* cache = GetSubsystem<ResourceCache>();
+    String byteCodeName = ReplaceExtension(scriptName, ".asc");
+
+    if(!cache->Exists(byteCodeName))
+        return false;
+
+    if(!IsByteCodeCurrent(cache->GetResourceFileName(scriptName), cache->GetResourceFileName(byteCodeName)))
+    {
+        URHO3D_LOGINFO("Bytecode of " + scriptName + " is older than the script sources, compiling the sources instead");
+        return false;
+    }
+
+    SharedPtr<File> file = cache->GetFile(byteCodeName);
+    if(!file)
+        return false;
+
+    //registered under the source name, so every user of the script gets the same module
+    SharedPtr<ScriptFile> scriptFile(new ScriptFile(context_));
+    scriptFile->SetName(scriptName);
+    if(!scriptFile->Load(*file) || !scriptFile->IsCompiled())
+    {
+        URHO3D_LOGWARNING("Could not load bytecode " + byteCodeName + ", compiling the script instead");
+        return false;
+    }
+
+    cache->AddManualResource(scriptFile);
+    URHO3D_LOGINFO("Loaded script " + scriptName + " from bytecode");
+
+    return true;
+}
+
+bool ScriptLoader::IsByteCodeCurrent(const String &sourceFileName, const String &byteCodeFileName) const
+{
+    //scripts inside a package can not be edited, the bytecode packaged with them is current
+    if(sourceFileName.Empty() || byteCodeFileName.Empty())
+        return true;
+
+    auto* fileSystem = GetSubsystem<FileSystem>();
+    unsigned byteCodeTime = fileSystem->GetLastModifiedTime(byteCodeFileName);
+
+    //the bytecode holds every included script as well, any of which may have been edited
+    String sourceDir = GetPath(sourceFileName);
+    Vector<String> sources;
+    fileSystem->ScanDir(sources, sourceDir, "*.as", SCAN_FILES, false);
+
+    for(unsigned i = 0; i < sources.Size(); ++i)
+    {
+        if(fileSystem->GetLastModifiedTime(sourceDir + sources[i]) > byteCodeTime)
+            return false;
+    }
+
+    return true;
+}
+
+bool ScriptLoader::CompileScripts()
+{
+    auto* cache = GetSubsystem<ResourceCache>();
+    auto* fileSystem = GetSubsystem<FileSystem>();
+
+    unsigned compiled = 0;
+    bool success = true;
+
+    const Vector<String>& resourceDirs = cache->GetResourceDirs();
+    for(unsigned i = 0; i < resourceDirs.Size(); ++i)
+    {
+        String scriptDir = resourceDirs[i] + SCRIPT_DIR;
+        if(!fileSystem->DirExists(scriptDir))
+            continue;
+
+        Vector<String> sources;
+        fileSystem->ScanDir(sources, scriptDir, "*.as", SCAN_FILES, false);
+
+        //scripts that are included by others are compiled as part of them
+        Vector<String> includes;
+        for(unsigned j = 0; j < sources.Size(); ++j)
+        {
+            File file(context_, scriptDir + sources[j]);
+            GetIncludes(file.ReadString(), includes);
+        }
+
+        for(unsigned j = 0; j < sources.Size(); ++j)
+        {
+            if(includes.Contains(sources[j]))
+                continue;
+
+            if(CompileScript(SCRIPT_DIR + sources[j], scriptDir + ReplaceExtension(sources[j], ".asc")))
+                ++compiled;
+            else
+                success = false;
+        }
+    }
+
+    URHO3D_LOGINFO("Compiled " + String(compiled) + " scripts to bytecode");
+
+    return success && compiled > 0;
+}
+
+bool ScriptLoader::CompileScript(const String &scriptName, const String &byteCodeFileName)
+{
+    auto* scriptFile = GetSubsystem<ResourceCache>()->GetResource<ScriptFile>(scriptName);
+    if(!scriptFile || !scriptFile->IsCompiled())
+    {
+        URHO3D_LOGERROR("Could not compile " + scriptName);
+        return false;
+    }
+
+    File file(context_, byteCodeFileName, FILE_WRITE);
+    if(!file.IsOpen() || !scriptFile->SaveByteCode(file))
+    {
+        URHO3D_LOGERROR("Could not write bytecode " + byteCodeFileName);
+        return false;
+    }
+
+    URHO3D_LOGINFO("Compiled " + scriptName + " to " + byteCodeFileName);
+
+    return true;
+}
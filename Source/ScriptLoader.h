@@ -0,0 +1,57 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef SCRIPTLOADER_H
+#define SCRIPTLOADER_H
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Core/Object.h>
+
+using namespace Urho3D;
+
+/// Loads the game scripts from precompiled bytecode when there is an up to date .asc file next to the source,
+/// falling back to compiling the source. Bytecode files are written by CompileScripts, which the game runs with
+/// the --compile-scripts option, since the scripts need the game's own script API to compile.
+class ScriptLoader : public Object
+{
+    URHO3D_OBJECT(ScriptLoader, Object)
+
+public:
+    ScriptLoader(Context* context);
+
+    /// Make the script available in the resource cache under its source name. Bytecode is loaded right away,
+    /// source is loaded in the background when requested, or else right away. Return true if bytecode was used.
+    bool Preload(const String& scriptName, bool background);
+    /// Compile every script under Scripts/ that is not included by another script and save its bytecode next
+    /// to the source. Return true if all of them compiled.
+    bool CompileScripts();
+
+private:
+    /// Load the bytecode of the script as a manual resource. Return true if successful.
+    bool LoadByteCode(const String& scriptName);
+    /// Return whether the bytecode is at least as new as every script source in its directory.
+    bool IsByteCodeCurrent(const String& sourceFileName, const String& byteCodeFileName) const;
+    /// Compile one script and save its bytecode. Return true if successful.
+    bool CompileScript(const String& scriptName, const String& byteCodeFileName);
+};
+
+#endif // SCRIPTLOADER_H
@@ -0,0 +1,85 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+#include <Urho3D/AngelScript/Script.h>
+#include <Urho3D/IO/Log.h>
+
+#include <AngelScript/angelscript.h>
+
+#include "ScriptMethod.h"
+
+CachedScriptMethod::CachedScriptMethod(const char *declaration)
+: declaration_(declaration)
+, type_(nullptr)
+, method_(nullptr)
+{
+
+}
+
+CachedScriptMethod::~CachedScriptMethod()
+{
+    if(type_)
+        type_->Release();
+}
+
+bool CachedScriptMethod::Execute(Script *script, asIScriptObject *object, float arg)
+{
+    asIScriptFunction* method = object ? GetMethod(object) : nullptr;
+    if(!script || !method)
+        return false;
+
+    //same direct call as LevelManager::ExecuteScriptMethod, on the context of the current nesting level
+    asIScriptContext* context = script->GetScriptFileContext();
+    if(context->Prepare(method) < 0)
+        return false;
+
+    context->SetObject(object);
+    context->SetArgFloat(0, arg);
+
+    script->IncScriptNestingLevel();
+    int result = context->Execute();
+    if(result == asEXECUTION_EXCEPTION)
+    {
+        asIScriptFunction* function = context->GetExceptionFunction();
+        URHO3D_LOGERROR("Exception '" + String(context->GetExceptionString()) + "' in '" +
+            String(function ? function->GetDeclaration() : method->GetDeclaration()) + "'");
+    }
+    context->Unprepare();
+    script->DecScriptNestingLevel();
+
+    return result == asEXECUTION_FINISHED;
+}
+
+asIScriptFunction* CachedScriptMethod::GetMethod(asIScriptObject *object)
+{
+    asITypeInfo* type = object->GetObjectType();
+    if(type == type_)
+        return method_;
+
+    if(type_)
+        type_->Release();
+
+    type_ = type;
+    type_->AddRef();
+    method_ = type_->GetMethodByDecl(declaration_);
+
+    return method_;
+}
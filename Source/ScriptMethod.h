@@ -0,0 +1,62 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+#ifndef SCRIPTMETHOD_H
+#define SCRIPTMETHOD_H
+
+#include <Urho3D/Urho3D.h>
+
+class asIScriptFunction;
+class asIScriptObject;
+class asITypeInfo;
+
+namespace Urho3D
+{
+    class Script;
+}
+
+using namespace Urho3D;
+
+/// Script method that is looked up once per script class and called directly on the script context. Used for calls
+/// in hot paths, which ScriptInstance::Execute would look up by declaration and pass a VariantVector to every time.
+class CachedScriptMethod
+{
+public:
+    /// Construct with the method declaration, which must outlive the cache.
+    explicit CachedScriptMethod(const char* declaration);
+    ~CachedScriptMethod();
+    CachedScriptMethod(const CachedScriptMethod&) = delete;
+    CachedScriptMethod& operator =(const CachedScriptMethod&) = delete;
+
+    /// Call the method of the object with a float argument. Return false if the object has no such method or the call failed.
+    bool Execute(Script* script, asIScriptObject* object, float arg);
+
+private:
+    /// Return the method for the class of the object, looked up again when the class differs from the last one.
+    asIScriptFunction* GetMethod(asIScriptObject* object);
+
+    const char* declaration_;
+    /// Class of the cached method, referenced so that a reloaded script cannot reuse its address.
+    asITypeInfo* type_;
+    asIScriptFunction* method_;
+};
+
+#endif // SCRIPTMETHOD_H
@@ -0,0 +1,98 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Scene/Scene.h>
+#include <Urho3D/Scene/SceneEvents.h>
+#include <Urho3D/Physics/PhysicsEvents.h>
+#include <Urho3D/Physics/PhysicsWorld.h>
+
+#include "SimulationClock.h"
+
+SimulationClock::SimulationClock(Context *context) : Component(context)
+, accumulator_(0.0f)
+, stepTime_(1.0f / 60.0f)
+{
+
+}
+
+void SimulationClock::RegisterObject(Context *context)
+{
+    context->RegisterFactory<SimulationClock>();
+}
+
+void SimulationClock::SetStepsPerSecond(int fps)
+{
+    Scene* scene = GetScene();
+    auto* physicsWorld = scene ? scene->GetComponent<PhysicsWorld>() : nullptr;
+    if(!physicsWorld || fps <= 0)
+        return;
+
+    physicsWorld->SetFps(fps);
+    //dynamic bodies are interpolated by the physics world itself
+    physicsWorld->SetInterpolation(true);
+    stepTime_ = 1.0f / (float)physicsWorld->GetFps();
+    accumulator_ = 0.0f;
+}
+
+float SimulationClock::GetInterpolation() const
+{
+    return Clamp(accumulator_ / stepTime_, 0.0f, 1.0f);
+}
+
+void SimulationClock::OnSceneSet(Scene *scene)
+{
+    if(scene)
+    {
+        SubscribeToEvent(scene, E_SCENEUPDATE, URHO3D_HANDLER(SimulationClock, HandleSceneUpdate));
+
+        auto* physicsWorld = scene->GetComponent<PhysicsWorld>();
+        if(physicsWorld)
+        {
+            stepTime_ = 1.0f / (float)physicsWorld->GetFps();
+            SubscribeToEvent(physicsWorld, E_PHYSICSPRESTEP, URHO3D_HANDLER(SimulationClock, HandlePhysicsPreStep));
+        }
+    }
+    else
+    {
+        UnsubscribeFromEvent(E_SCENEUPDATE);
+        UnsubscribeFromEvent(E_PHYSICSPRESTEP);
+    }
+}
+
+void SimulationClock::HandleSceneUpdate(StringHash eventType, VariantMap &eventData)
+{
+    using namespace SceneUpdate;
+
+    //less than a step is left after the last frame, unless the physics world dropped time after too many steps
+    accumulator_ = Min(accumulator_, stepTime_);
+    //the physics world steps after the scene update, in the same frame
+    accumulator_ += eventData[P_TIMESTEP].GetFloat();
+}
+
+void SimulationClock::HandlePhysicsPreStep(StringHash eventType, VariantMap &eventData)
+{
+    using namespace PhysicsPreStep;
+
+    stepTime_ = eventData[P_TIMESTEP].GetFloat();
+    accumulator_ = Max(accumulator_ - stepTime_, 0.0f);
+}
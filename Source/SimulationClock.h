@@ -0,0 +1,60 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef SIMULATIONCLOCK_H
+#define SIMULATIONCLOCK_H
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Scene/Component.h>
+
+using namespace Urho3D;
+
+/// Tracks how far rendering is ahead of the last physics step of the scene, so that natively simulated nodes
+/// can be drawn between their last two simulated positions. Lets the physics step rate be lowered without stutter.
+class SimulationClock : public Component
+{
+    URHO3D_OBJECT(SimulationClock, Component)
+
+public:
+    SimulationClock(Context* context);
+
+    static void RegisterObject(Context* context);
+
+    /// Set the number of physics steps per second.
+    void SetStepsPerSecond(int fps);
+    /// Return the fraction of a physics step that has passed since the last one, between 0 and 1.
+    float GetInterpolation() const;
+
+protected:
+    void OnSceneSet(Scene* scene) override;
+
+private:
+    void HandleSceneUpdate(StringHash eventType, VariantMap& eventData);
+    void HandlePhysicsPreStep(StringHash eventType, VariantMap& eventData);
+
+    /// Scene time not yet covered by physics steps.
+    float accumulator_;
+    /// Length of a physics step.
+    float stepTime_;
+};
+
+#endif // SIMULATIONCLOCK_H
@@ -0,0 +1,209 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Audio/Audio.h>
+#include <Urho3D/Audio/Sound.h>
+#include <Urho3D/Audio/SoundListener.h>
+#include <Urho3D/Audio/SoundSource3D.h>
+#include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/Scene/Scene.h>
+
+#include "PerfCounters.h"
+#include "SoundVoiceManager.h"
+
+SoundVoiceManager::SoundVoiceManager(Context *context) : Component(context)
+, voiceCount_(16)
+, maxVoicesPerSound_(4)
+, nearDistance_(0.2f)
+, farDistance_(120.0f)
+, rolloffFactor_(0.1f)
+{
+
+}
+
+void SoundVoiceManager::RegisterObject(Context *context)
+{
+    context->RegisterFactory<SoundVoiceManager>();
+
+    URHO3D_ATTRIBUTE("Voice Count", voiceCount_, 16, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Max Voices Per Sound", maxVoicesPerSound_, 4, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Near Distance", nearDistance_, 0.2f, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Far Distance", farDistance_, 120.0f, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Rolloff Factor", rolloffFactor_, 0.1f, AM_DEFAULT);
+}
+
+bool SoundVoiceManager::PlaySound(const String &name, const Vector3 &position, int priority)
+{
+    PerfScope scope(GetSubsystem<PerfCounters>(), "SoundVoiceManager::PlaySound");
+
+    Sound* sound = GetSound(name);
+    if(!sound || voices_.Empty())
+        return false;
+
+    auto* audio = GetSubsystem<Audio>();
+    SoundListener* listener = audio ? audio->GetListener() : nullptr;
+    Vector3 listenerPosition = listener && listener->GetNode() ? listener->GetNode()->GetWorldPosition() : Vector3::ZERO;
+    float distance = (position - listenerPosition).LengthSquared();
+
+    StringHash soundName(name);
+    int sameSoundCount = 0;
+    Voice* freeVoice = nullptr;
+    Voice* weakestVoice = nullptr;
+    Voice* weakestSameVoice = nullptr;
+    float weakestDistance = 0.0f;
+    float weakestSameDistance = 0.0f;
+
+    for(unsigned i = 0; i < voices_.Size(); ++i)
+    {
+        Voice& voice = voices_[i];
+        if(!voice.source_)
+            continue;
+
+        if(!voice.source_->IsPlaying())
+        {
+            if(!freeVoice)
+                freeVoice = &voice;
+            continue;
+        }
+
+        float voiceDistance = (voice.node_->GetWorldPosition() - listenerPosition).LengthSquared();
+
+        if(!weakestVoice || IsWeaker(voice, voiceDistance, *weakestVoice, weakestDistance))
+        {
+            weakestVoice = &voice;
+            weakestDistance = voiceDistance;
+        }
+
+        if(voice.sound_ == soundName)
+        {
+            ++sameSoundCount;
+            if(!weakestSameVoice || IsWeaker(voice, voiceDistance, *weakestSameVoice, weakestSameDistance))
+            {
+                weakestSameVoice = &voice;
+                weakestSameDistance = voiceDistance;
+            }
+        }
+    }
+
+    Voice* target = nullptr;
+
+    if(sameSoundCount >= maxVoicesPerSound_)
+    {
+        //at the cap the sound can only replace one of its own voices, the newest of equal priority wins
+        if(weakestSameVoice && weakestSameVoice->priority_ <= priority)
+            target = weakestSameVoice;
+    }
+    else if(freeVoice)
+    {
+        target = freeVoice;
+    }
+    else if(weakestVoice)
+    {
+        //all voices are busy, take over the weakest one unless the new sound is weaker still
+        Voice candidate;
+        candidate.priority_ = priority;
+        if(!IsWeaker(candidate, distance, *weakestVoice, weakestDistance))
+            target = weakestVoice;
+    }
+
+    if(!target)
+        return false;
+
+    target->node_->SetWorldPosition(position);
+    target->source_->Play(sound);
+    target->sound_ = soundName;
+    target->priority_ = priority;
+
+    return true;
+}
+
+void SoundVoiceManager::StopAll()
+{
+    for(unsigned i = 0; i < voices_.Size(); ++i)
+    {
+        if(voices_[i].source_)
+            voices_[i].source_->Stop();
+    }
+}
+
+unsigned SoundVoiceManager::GetPlayingCount() const
+{
+    unsigned count = 0;
+
+    for(unsigned i = 0; i < voices_.Size(); ++i)
+    {
+        if(voices_[i].source_ && voices_[i].source_->IsPlaying())
+            ++count;
+    }
+
+    return count;
+}
+
+void SoundVoiceManager::OnSceneSet(Scene *scene)
+{
+    if(scene && !voiceRoot_)
+    {
+        voiceRoot_ = scene->CreateChild("SoundVoices", LOCAL);
+        CreateVoices();
+    }
+}
+
+void SoundVoiceManager::CreateVoices()
+{
+    voices_.Resize(Max(voiceCount_, 1));
+
+    for(unsigned i = 0; i < voices_.Size(); ++i)
+    {
+        Voice& voice = voices_[i];
+        voice.node_ = voiceRoot_->CreateChild(String::EMPTY, LOCAL);
+        voice.priority_ = 0;
+
+        auto* source = voice.node_->CreateComponent<SoundSource3D>();
+        source->SetSoundType(SOUND_EFFECT);
+        source->SetDistanceAttenuation(nearDistance_, farDistance_, rolloffFactor_);
+        voice.source_ = source;
+    }
+}
+
+Sound* SoundVoiceManager::GetSound(const String &name)
+{
+    StringHash soundName(name);
+
+    auto it = sounds_.Find(soundName);
+    if(it != sounds_.End())
+        return it->second_;
+
+    //missing sounds are remembered too, so the failed lookup is only logged once
+    SharedPtr<Sound> sound(GetSubsystem<ResourceCache>()->GetResource<Sound>(name));
+    sounds_[soundName] = sound;
+
+    return sound;
+}
+
+bool SoundVoiceManager::IsWeaker(const Voice &a, float distanceA, const Voice &b, float distanceB) const
+{
+    if(a.priority_ != b.priority_)
+        return a.priority_ < b.priority_;
+
+    return distanceA > distanceB;
+}
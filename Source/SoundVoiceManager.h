@@ -0,0 +1,88 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef SOUNDVOICEMANAGER_H
+#define SOUNDVOICEMANAGER_H
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Scene/Component.h>
+#include <Urho3D/Scene/Node.h>
+#include <Urho3D/Container/HashMap.h>
+
+namespace Urho3D
+{
+    class Sound;
+    class SoundSource3D;
+}
+
+using namespace Urho3D;
+
+/// Plays positional sound effects on a fixed set of reusable 3D voices. Each sound may only hold a limited
+/// number of voices, and when no voice is free the one with the lowest priority, then the farthest from the
+/// listener, is taken over. Sounds are looked up once and kept.
+class SoundVoiceManager : public Component
+{
+    URHO3D_OBJECT(SoundVoiceManager, Component)
+
+public:
+    SoundVoiceManager(Context* context);
+
+    static void RegisterObject(Context* context);
+
+    /// Play a sound at a world position. Return false if the sound was dropped in favour of playing voices.
+    bool PlaySound(const String& name, const Vector3& position, int priority = 0);
+    /// Stop all voices.
+    void StopAll();
+    /// Return number of voices currently playing.
+    unsigned GetPlayingCount() const;
+
+protected:
+    void OnSceneSet(Scene* scene) override;
+
+private:
+    struct Voice
+    {
+        SharedPtr<Node> node_;
+        WeakPtr<SoundSource3D> source_;
+        StringHash sound_;
+        int priority_;
+    };
+
+    /// Build the voice nodes.
+    void CreateVoices();
+    /// Return cached sound by name, loading it on first use.
+    Sound* GetSound(const String& name);
+    /// Return whether voice a should be taken over before voice b.
+    bool IsWeaker(const Voice& a, float distanceA, const Voice& b, float distanceB) const;
+
+    int voiceCount_;
+    int maxVoicesPerSound_;
+    float nearDistance_;
+    float farDistance_;
+    float rolloffFactor_;
+
+    WeakPtr<Node> voiceRoot_;
+    Vector<Voice> voices_;
+    HashMap<StringHash, SharedPtr<Sound> > sounds_;
+};
+
+#endif // SOUNDVOICEMANAGER_H
@@ -0,0 +1,71 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/IO/FileSystem.h>
+
+#include "TextureRouter.h"
+
+TextureRouter::TextureRouter(Context *context) : ResourceRouter(context)
+{
+
+}
+
+void TextureRouter::Route(String &name, ResourceRequest requestType)
+{
+    //only the file reads are routed, checks for the original name still see the original
+    if(requestType != RESOURCE_GETFILE)
+        return;
+
+    String extension = GetExtension(name);
+    if(extension != ".png" && extension != ".jpg")
+        return;
+
+    StringHash nameHash(name);
+    HashMap<StringHash, String>::Iterator i = routes_.Find(nameHash);
+    if(i == routes_.End())
+        i = routes_.Insert(MakePair(nameHash, FindCompressed(name)));
+
+    if(!i->second_.Empty())
+        name = i->second_;
+}
+
+String TextureRouter::FindCompressed(const String &name) const
+{
+    auto* cache = GetSubsystem<ResourceCache>();
+    String compressedName = ReplaceExtension(name, ".dds");
+
+    if(!cache->Exists(compressedName))
+        return String::EMPTY;
+
+    //an image edited after the last compression is used as it is until the textures are compressed again
+    String sourceFileName = cache->GetResourceFileName(name);
+    String compressedFileName = cache->GetResourceFileName(compressedName);
+    if(!sourceFileName.Empty() && !compressedFileName.Empty())
+    {
+        auto* fileSystem = GetSubsystem<FileSystem>();
+        if(fileSystem->GetLastModifiedTime(sourceFileName) > fileSystem->GetLastModifiedTime(compressedFileName))
+            return String::EMPTY;
+    }
+
+    return compressedName;
+}
@@ -0,0 +1,52 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef TEXTUREROUTER_H
+#define TEXTUREROUTER_H
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Container/HashMap.h>
+#include <Urho3D/Resource/ResourceCache.h>
+
+using namespace Urho3D;
+
+/// Serves the compressed .dds file written by the CompressTextures target in place of a PNG or JPG texture image,
+/// so materials keep naming the original images, which are still used when there is no up to date .dds.
+class TextureRouter : public ResourceRouter
+{
+    URHO3D_OBJECT(TextureRouter, ResourceRouter)
+
+public:
+    TextureRouter(Context* context);
+
+    /// Replace the name of a texture image that has a compressed version.
+    void Route(String& name, ResourceRequest requestType) override;
+
+private:
+    /// Return the name of the compressed version of an image, or empty if there is none.
+    String FindCompressed(const String& name) const;
+
+    /// Routed names by original image name, empty when the original is used.
+    HashMap<StringHash, String> routes_;
+};
+
+#endif // TEXTUREROUTER_H
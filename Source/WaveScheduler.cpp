@@ -0,0 +1,218 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Core/StringUtils.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/Physics/PhysicsEvents.h>
+#include <Urho3D/Physics/PhysicsWorld.h>
+#include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/Resource/XMLFile.h>
+#include <Urho3D/Scene/Scene.h>
+
+#include "DroneSwarmSystem.h"
+#include "EntityIndex.h"
+#include "GameRandom.h"
+#include "PerfCounters.h"
+#include "PrefabCache.h"
+#include "WaveScheduler.h"
+
+static const char* formationNames[] =
+{
+    "random",
+    "ring",
+    nullptr
+};
+
+WaveScheduler::WaveScheduler(Context *context) : Component(context)
+, droneObjectFile_("Objects/LowLevelDrone.xml")
+, spawnOffset_(0.0f, 4.0f, 40.0f)
+, elapsedTime_(0.0f)
+, dronesSpawned_(0)
+{
+
+}
+
+void WaveScheduler::RegisterObject(Context *context)
+{
+    context->RegisterFactory<WaveScheduler>();
+
+    URHO3D_ATTRIBUTE("Drone Object File", droneObjectFile_, String("Objects/LowLevelDrone.xml"), AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Spawn Offset", spawnOffset_, Vector3(0.0f, 4.0f, 40.0f), AM_DEFAULT);
+}
+
+bool WaveScheduler::LoadSchedule(const String &fileName)
+{
+    auto* file = GetSubsystem<ResourceCache>()->GetResource<XMLFile>(fileName);
+    if(!file)
+        return false;
+
+    XMLElement root = file->GetRoot("waveschedule");
+    if(!root)
+    {
+        URHO3D_LOGERROR("Wave schedule " + fileName + " has no waveschedule element");
+        return false;
+    }
+
+    waves_.Clear();
+
+    for(XMLElement waveElem = root.GetChild("wave"); waveElem; waveElem = waveElem.GetNext("wave"))
+    {
+        Wave wave;
+        wave.start_ = waveElem.HasAttribute("start") ? waveElem.GetFloat("start") : 0.0f;
+        wave.duration_ = waveElem.HasAttribute("duration") ? waveElem.GetFloat("duration") : 0.0f;
+        wave.interval_ = waveElem.HasAttribute("interval") ? waveElem.GetFloat("interval") : 0.0f;
+        wave.count_ = waveElem.HasAttribute("count") ? waveElem.GetUInt("count") : 1;
+        wave.cap_ = waveElem.HasAttribute("cap") ? waveElem.GetUInt("cap") : M_MAX_UNSIGNED;
+        wave.formation_ = (WaveFormation)GetStringListIndex(waveElem.GetAttribute("formation").CString(), formationNames,
+            WF_RANDOM);
+        waves_.Push(wave);
+    }
+
+    Restart();
+    return true;
+}
+
+void WaveScheduler::Restart()
+{
+    elapsedTime_ = 0.0f;
+    dronesSpawned_ = 0;
+
+    for(unsigned i = 0; i < waves_.Size(); ++i)
+    {
+        Wave& wave = waves_[i];
+        wave.timer_ = 0.0f;
+        wave.ringOffset_ = 0.0f;
+        wave.pending_ = 0;
+        wave.burstStarted_ = false;
+    }
+}
+
+void WaveScheduler::OnSceneSet(Scene *scene)
+{
+    if(scene)
+    {
+        auto* physicsWorld = scene->GetComponent<PhysicsWorld>();
+        if(physicsWorld)
+        {
+            SubscribeToEvent(physicsWorld, E_PHYSICSPRESTEP, URHO3D_HANDLER(WaveScheduler, HandlePhysicsPreStep));
+        }
+    }
+    else
+    {
+        UnsubscribeFromEvent(E_PHYSICSPRESTEP);
+    }
+}
+
+void WaveScheduler::HandlePhysicsPreStep(StringHash eventType, VariantMap &eventData)
+{
+    using namespace PhysicsPreStep;
+
+    if(waves_.Empty())
+        return;
+
+    PerfScope scope(GetSubsystem<PerfCounters>(), "WaveScheduler::Update");
+    float timeStep = eventData[P_TIMESTEP].GetFloat();
+
+    elapsedTime_ += timeStep;
+
+    //the waves share the live drone count, so a wave sees the drones the waves before it spawned this step
+    unsigned liveDrones = GetLiveDrones();
+    for(unsigned i = 0; i < waves_.Size(); ++i)
+    {
+        liveDrones += UpdateWave(waves_[i], timeStep, liveDrones);
+    }
+}
+
+unsigned WaveScheduler::UpdateWave(Wave &wave, float timeStep, unsigned liveDrones)
+{
+    if(elapsedTime_ < wave.start_ || (wave.duration_ > 0.0f && elapsedTime_ >= wave.start_ + wave.duration_))
+        return 0;
+
+    unsigned room = liveDrones < wave.cap_ ? wave.cap_ - liveDrones : 0;
+
+    //a burst spawns all its drones at once, or as soon as the cap lets it
+    if(wave.interval_ <= 0.0f)
+    {
+        if(!wave.burstStarted_)
+        {
+            wave.burstStarted_ = true;
+            wave.pending_ = wave.count_;
+            wave.ringOffset_ = GetSubsystem<GameRandom>()->Random(360.0f);
+        }
+
+        unsigned count = Min(wave.pending_, room);
+        SpawnDrones(wave, wave.count_ - wave.pending_, count);
+        wave.pending_ -= count;
+        return count;
+    }
+
+    //the timer keeps running while the cap is reached, so the next drone comes as soon as there is room
+    wave.timer_ += timeStep;
+    if(wave.timer_ < wave.interval_ || room == 0)
+        return 0;
+
+    unsigned count = Min(wave.count_, room);
+    wave.ringOffset_ = GetSubsystem<GameRandom>()->Random(360.0f);
+    SpawnDrones(wave, 0, count);
+    wave.timer_ = 0.0f;
+    return count;
+}
+
+void WaveScheduler::SpawnDrones(const Wave &wave, unsigned first, unsigned count)
+{
+    auto* random = GetSubsystem<GameRandom>();
+
+    for(unsigned i = first; i < first + count; ++i)
+    {
+        float bearing = wave.formation_ == WF_RING ? wave.ringOffset_ + i * 360.0f / wave.count_ : random->Random(360.0f);
+        if(SpawnDrone(bearing))
+        {
+            ++dronesSpawned_;
+        }
+    }
+}
+
+Node* WaveScheduler::SpawnDrone(float bearing)
+{
+    Scene* scene = GetScene();
+    if(!scene)
+        return nullptr;
+
+    auto* swarm = scene->GetComponent<DroneSwarmSystem>();
+    if(swarm)
+        return swarm->SpawnDrone(bearing);
+
+    Quaternion rot(0.0f, bearing, 0.0f);
+    return GetSubsystem<PrefabCache>()->SpawnPrefab(scene, droneObjectFile_, rot * spawnOffset_, rot);
+}
+
+unsigned WaveScheduler::GetLiveDrones() const
+{
+    Scene* scene = GetScene();
+    auto* entityIndex = scene ? scene->GetComponent<EntityIndex>() : nullptr;
+    if(entityIndex)
+        return entityIndex->GetTaggedCount("drone");
+
+    auto* swarm = scene ? scene->GetComponent<DroneSwarmSystem>() : nullptr;
+    return swarm ? swarm->GetDroneCount() : 0;
+}
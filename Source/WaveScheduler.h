@@ -0,0 +1,107 @@
+//
+// Copyright (c) 2014 - 2021 Drone Anarchy.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef WAVESCHEDULER_H
+#define WAVESCHEDULER_H
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Scene/Component.h>
+
+using namespace Urho3D;
+
+/// Arrangements a wave spawns its drones in.
+enum WaveFormation
+{
+    WF_RANDOM = 0,
+    WF_RING
+};
+
+/// Spawns the drones of a scene by a schedule of waves loaded from XML. A wave is active from its start time for
+/// its duration and either spawns a number of drones every interval, or once as a burst. The drones take random
+/// bearings on the spawn ring or are spread evenly around it, and a wave only spawns while fewer drones than its
+/// cap are alive. Drones are spawned by the DroneSwarmSystem of the scene, or from a prefab without one.
+class WaveScheduler : public Component
+{
+    URHO3D_OBJECT(WaveScheduler, Component)
+
+public:
+    WaveScheduler(Context* context);
+
+    static void RegisterObject(Context* context);
+
+    /// Load a wave schedule and restart it. Return true if successful.
+    bool LoadSchedule(const String& fileName);
+    /// Restart the schedule from the beginning.
+    void Restart();
+
+    /// Return time since the schedule started.
+    float GetElapsedTime() const { return elapsedTime_; }
+    /// Return number of waves in the schedule.
+    unsigned GetNumWaves() const { return waves_.Size(); }
+    /// Return number of drones spawned since the schedule started.
+    unsigned GetDronesSpawned() const { return dronesSpawned_; }
+
+protected:
+    void OnSceneSet(Scene* scene) override;
+
+private:
+    struct Wave
+    {
+        float start_;
+        /// Time the wave stays active, or zero to stay active until the end.
+        float duration_;
+        /// Time between spawns, or zero to spawn once.
+        float interval_;
+        /// Drones per spawn.
+        unsigned count_;
+        /// Live drones above which the wave does not spawn.
+        unsigned cap_;
+        WaveFormation formation_;
+
+        float timer_;
+        /// Bearing of the first drone of a ring.
+        float ringOffset_;
+        /// Drones of a burst that have not been spawned yet because the cap was reached.
+        unsigned pending_;
+        bool burstStarted_;
+    };
+
+    void HandlePhysicsPreStep(StringHash eventType, VariantMap& eventData);
+
+    /// Advance a wave and spawn its drones. Return number of drones spawned.
+    unsigned UpdateWave(Wave& wave, float timeStep, unsigned liveDrones);
+    /// Spawn drones of a wave, the first of them at the index within the formation.
+    void SpawnDrones(const Wave& wave, unsigned first, unsigned count);
+    Node* SpawnDrone(float bearing);
+    /// Return number of live drones.
+    unsigned GetLiveDrones() const;
+
+    /// Prefab of the drones when the scene has no drone swarm.
+    String droneObjectFile_;
+    Vector3 spawnOffset_;
+
+    PODVector<Wave> waves_;
+    float elapsedTime_;
+    unsigned dronesSpawned_;
+};
+
+#endif // WAVESCHEDULER_H
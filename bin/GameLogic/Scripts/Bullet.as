@@ -29,8 +29,10 @@ abstract class Bullet : ScriptObject
 	float termTimeCounter_;
 	BulletObjectType bulletObjectType_;
 	float damagePoint_;
+	float speed_;
 	
-	void DelayedStart()
+	//components are built once here, bullet nodes are recycled through the node pool
+	void Start()
 	{
 		SubscribeToEvent(node, "NodeCollision", "HandleNodeCollision");
 		Initialise();
@@ -38,6 +40,22 @@ abstract class Bullet : ScriptObject
 	
 	void Initialise(){}
 	
+	//called each time the bullet is fired
+	void OnAcquired()
+	{
+		termTimeCounter_ = 0;
+		
+		ParticleEmitter@ pEmitter = node.GetComponent("ParticleEmitter");
+		if(pEmitter !is null)
+		{
+			pEmitter.RemoveAllParticles();
+			pEmitter.Reset();
+		}
+		
+		RigidBody@ objBody = node.GetComponent("RigidBody");
+		objBody.linearVelocity = node.rotation * Vector3(0,0,speed_);
+	}
+	
 	void FixedUpdate(float timestep)
 	{
 		termTimeCounter_ += timestep;
@@ -50,6 +68,8 @@ abstract class Bullet : ScriptObject
 	
 	void HandleNodeCollision(StringHash eventType, VariantMap& eventData)
 	{
+		perf.BeginScope("Bullet.Collision");
+
 		Node@ otherNode = eventData["OtherNode"].GetPtr();
 		Drone@ droneObj = cast<Drone>(otherNode.scriptObject);
 		
@@ -57,13 +77,28 @@ abstract class Bullet : ScriptObject
 		{
 			droneObj.OnHit(damagePoint_);
 		}
+		else
+		{
+			//drones simulated natively have no script object
+			DroneSwarmSystem@ droneSwarm = node.scene.droneSwarm;
+			if(droneSwarm !is null)
+			{
+				droneSwarm.ApplyHit(otherNode, damagePoint_);
+			}
+		}
 		
 		Destroy();
+
+		perf.EndScope();
 	}
 	
 	void Destroy()
 	{
-		node.Remove();
+		NodePool@ nodePool = node.scene.nodePool;
+		if(nodePool is null || !nodePool.Release(node))
+		{
+			node.Remove();
+		}
 	}
 	
 }
@@ -77,6 +112,7 @@ class LowLevelBullet : Bullet
 		termTime_ = 1;
 		termTimeCounter_ = 0;
 		damagePoint_ = 1;
+		speed_ = 70;
 	}
 	
 	void Initialise()
@@ -100,7 +136,6 @@ class LowLevelBullet : Bullet
 		
 		CollisionShape@ objShape = node.CreateComponent("CollisionShape");
 		objShape.SetSphere(0.3f);
-		objBody.linearVelocity = node.rotation * Vector3(0,0,70);
 	}
 
 }
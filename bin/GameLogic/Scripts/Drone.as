@@ -59,8 +59,6 @@ abstract class Drone : ScriptObject
 	
 	void Destroy()
 	{
-		Sprite@ nodeSprite = node.vars["Sprite"].GetPtr();
-		nodeSprite.Remove();
 		node.Remove();
 	}
 	
@@ -87,16 +85,6 @@ class LowLevelDrone : Drone
 		damagePoint_ = 2;
 	}
 	
-	void Start()
-	{
-		float nodeYaw = Random(360);
-		Quaternion rot = Quaternion(0,nodeYaw, 0);
-		
-		node.SetTransform(rot * Vector3(0,4,40), rot);
-		//node.rotation = Quaternion(0,nodeYaw, 0);
-		//node.Translate(Vector3(0,7,40));
-	}
-	
 	void DelayedStart()
 	{
 		Drone::DelayedStart();
@@ -129,6 +117,8 @@ class LowLevelDrone : Drone
 	
 	void HandleNodeCollision(StringHash eventType, VariantMap& eventData)
 	{
+		perf.BeginScope("Drone.Collision");
+
 		Node@ otherNode = eventData["OtherNode"].GetPtr();
 		PlayerObject@ playerObj = cast<PlayerObject>(otherNode.scriptObject);
 		
@@ -137,6 +127,8 @@ class LowLevelDrone : Drone
 			playerObj.OnHit(damagePoint_);
 			Destroy();
 		}
+
+		perf.EndScope();
 	}
 	
 	void Attack()
@@ -161,17 +153,22 @@ class LowLevelDrone : Drone
 	
 	void OnDestroyed()
 	{
-		VariantMap eventData;
-		eventData["DronePoint"] = dronePoint_;
-		SendEvent("DroneDestroyed", eventData);
+		gameEvents.Post(DroneDestroyedEvent(dronePoint_));
 		
 		SpawnExplosion();
 	}
 	
 	void SpawnExplosion()
 	{
+		NodePool@ nodePool = node.scene.nodePool;
+		if(nodePool !is null && nodePool.Acquire("SimpleExplosion", node.worldPosition, Quaternion()) !is null)
+		{
+			return;
+		}
+		
 		Node@ explosionNode = node.scene.CreateChild("ExplosionNode");
 		explosionNode.worldPosition = node.worldPosition;	 
-		explosionNode.CreateScriptObject(scriptFile, "SimpleExplosion");
+		ExplosionObjectBase@ explosion = cast<ExplosionObjectBase>(explosionNode.CreateScriptObject(scriptFile, "SimpleExplosion"));
+		explosion.OnAcquired();
 	}
 }
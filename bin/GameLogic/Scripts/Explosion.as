@@ -27,13 +27,35 @@
 abstract class ExplosionObjectBase : ScriptObject
 {
 	float duration_;
+	float lifeTime_;
 	
-	void DelayedStart()
+	//components are built once here, explosion nodes are recycled through the node pool
+	void Start()
 	{
 		Initialise();
 	}
 	
 	void Initialise(){}
+	
+	//called each time the explosion is spawned
+	void OnAcquired()
+	{
+		duration_ = lifeTime_;
+	}
+	
+	//called when the explosion goes back to the node pool
+	void OnReleased()
+	{
+	}
+	
+	void Destroy()
+	{
+		NodePool@ nodePool = node.scene.nodePool;
+		if(nodePool is null || !nodePool.Release(node))
+		{
+			node.Remove();
+		}
+	}
 }
 
 ///Explosion Object
@@ -41,7 +63,8 @@ class SimpleExplosion : ExplosionObjectBase
 {
 	SimpleExplosion()
 	{
-		duration_ = 0.78f;
+		lifeTime_ = 0.78f;
+		duration_ = lifeTime_;
 	}
 	
 	void FixedUpdate(float timestep)
@@ -49,7 +72,7 @@ class SimpleExplosion : ExplosionObjectBase
 		duration_ -= timestep;
 		if(duration_ < 0.0f)
 		{
-			node.Remove();
+			Destroy();
 		}
 	}
 	
@@ -58,10 +81,17 @@ class SimpleExplosion : ExplosionObjectBase
 		ParticleEmitter@ pEmitter = node.CreateComponent("ParticleEmitter");
 		pEmitter.effect = cache.GetResource("ParticleEffect", "Particles/explosion.xml");
 		pEmitter.enabled = true;
+	}
+	
+	void OnAcquired()
+	{
+		ExplosionObjectBase::OnAcquired();
+		
+		ParticleEmitter@ pEmitter = node.GetComponent("ParticleEmitter");
+		pEmitter.RemoveAllParticles();
+		pEmitter.Reset();
+		pEmitter.emitting = true;
 		
-		VariantMap eventData;
-		eventData["SoundNode"] = node;
-		eventData["SoundName"] = "Sounds/explosion.ogg";
-		SendEvent("SoundGenerated", eventData);
+		node.scene.PlaySound("Sounds/explosion.ogg", node.worldPosition, SOUND_PRIORITY_EXPLOSION);
 	}
 }
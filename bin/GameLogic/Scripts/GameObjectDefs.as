@@ -50,3 +50,8 @@ const int PLAYER_COLLISION_LAYER = 2;
 const int DRONE_COLLISION_LAYER = 3;
 const int FLOOR_COLLISION_LAYER = 5;
 const int SCORE_ADDITION_RATE = 1;
+
+//Sound Priorities, higher priority sounds take over the voices of lower ones
+const int SOUND_PRIORITY_WEAPON = 0;
+const int SOUND_PRIORITY_EXPLOSION = 1;
+const int SOUND_PRIORITY_PLAYER_HIT = 2;
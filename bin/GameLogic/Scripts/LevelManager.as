@@ -45,6 +45,11 @@ const int DRONE_COLLISION_LAYER = 3;
 const int FLOOR_COLLISION_LAYER = 5;
 const int SCORE_ADDITION_RATE = 1;
 
+//Sound Priorities, higher priority sounds take over the voices of lower ones
+const int SOUND_PRIORITY_WEAPON = 0;
+const int SOUND_PRIORITY_EXPLOSION = 1;
+const int SOUND_PRIORITY_PLAYER_HIT = 2;
+
 enum LevelState
 {
 	LS_INGAME = 101,
@@ -97,6 +102,7 @@ abstract class LevelManager : ScriptObject
 	}
 	
 	void SetupLevel(){}
+	void StartBenchmark(VariantMap& settings){}
 	
 	void HandleLevelEvent(VariantMap& eventData)
 	{
@@ -110,9 +116,6 @@ abstract class LevelManager : ScriptObject
 		case EVT_KEYDOWN:
 			HandleKeyDown(eventData);
 			break;
-		case EVT_MOUSEMOVE:
-			HandleMouseMove(eventData);
-			break;	
 		case EVT_SOUNDFINISH:
 			HandleSoundFinish(eventData);
 			break;	
@@ -133,7 +136,6 @@ abstract class LevelManager : ScriptObject
 	
 	void HandleUpdate(VariantMap& eventData){}
 	void HandleKeyDown(VariantMap& eventData){}
-	void HandleMouseMove(VariantMap& eventData){}
 	void HandleSoundFinish(VariantMap& eventData){}
 	void HandleJoystickButtonDown(VariantMap& eventData){}
 	void HandleJoystickButtonUp(VariantMap& eventData){}
@@ -142,6 +144,10 @@ abstract class LevelManager : ScriptObject
 	
 	protected void SetViewportCamera(Camera@ viewCamera)
 	{
+		if(renderer is null)
+		{
+			return;
+		}
 		renderer.viewports[0] = Viewport(scene, viewCamera);
 	}
 	
@@ -168,25 +174,22 @@ abstract class LevelManager : ScriptObject
 
 class LevelOneManager : LevelManager
 {
-	uint MAX_DRONE_COUNT = 15;
-
-	float EASY_PHASE = 0;
-	float MODERATE_PHASE = 60;
-	float CRITICAL_PHASE = 120;
-	float EASY_PHASE_RATE = 3.5;
-	float MODERATE_PHASE_RATE = 2.5;
-	float CRITICAL_PHASE_RATE = 1;
+	//drones are spawned by the waves of this schedule
+	String WAVE_SCHEDULE_FILE = "Waves/LevelOne.xml";
+
 	float SCENE_TO_UI_SCALE = 1.6f;
-	float SPRITE_UPDATE_TIME = 0.04f;
+	float COUNTER_UPDATE_TIME = 0.04f;
+	float RADAR_RANGE = 40.0f;
 
+	//when set, drones are simulated by the native DroneSwarmSystem instead of LowLevelDrone script objects
+	bool USE_NATIVE_SWARM = true;
+
+	String DRONE_OBJECT_FILE = "Objects/LowLevelDrone.xml";
 	String NORMAL_DRONE_SPRITE = "Textures/drone_sprite.png";
-	String ALTERNATE_DRONE_SPRITE = "Textures/alt_drone_sprite.png";
 	
 	int playerScore_ = 0;
 
-	float spriteUpdateCounter_ = 0.0f;
-	float droneSpawnCounter_ = 0.0f;
-	float gamePhaseCounter_ = 0.0f;
+	float counterUpdateCounter_ = 0.0f;
     float tempCounterSpeed_ = 0.0f;
 	
 	bool playerDestroyed_ = false;
@@ -198,16 +201,26 @@ class LevelOneManager : LevelManager
 	LevelState levelState_ = LS_FIRSTRUN;
 
     bool isWeb_ = GetPlatform() == "Web";
+	//benchmarks run without a renderer
+	bool isHeadless_ = renderer is null;
+	bool playerInvulnerable_ = false;
 
 	Node@ cameraNode_;
 	Node@ playerNode_;
 
-	Viewport@ viewport_ = renderer.viewports[0];
+	DroneSwarmSystem@ droneSwarm_;
+	EntityIndex@ entityIndex_;
+	NodePool@ nodePool_;
+	ProjectileSystem@ projectiles_;
+	WaveScheduler@ waves_;
+
+	Viewport@ viewport_;
 
 	ValueAnimation@ damageAnimation_;
 	ValueAnimation@ textAnimation_;
 
 	Sprite@ radarScreenBase_;
+	RadarDisplay@ radar_;
 	Sprite@ healthFillSprite_;
 	Sprite@ targetSprite_;
 
@@ -223,6 +236,14 @@ class LevelOneManager : LevelManager
     UIElement@ displayRoot_;
 	
 	virtualController@ myjoystick_ = virtualController();
+
+	void SetLevelState(LevelState state)
+	{
+		levelState_ = state;
+		//the script GC gets its larger budget while no gameplay frames run
+		scriptGC.idle = state != LS_INGAME;
+	}
+
 	void Activate()
 	{
 		LevelManager::Activate();
@@ -258,7 +279,7 @@ class LevelOneManager : LevelManager
     {
         if( levelState_ == LS_FIRSTRUN )
         {
-            levelState_ = LS_OUTGAME;
+            SetLevelState(LS_OUTGAME);
 
 		    SetupLevel();
         }
@@ -287,10 +308,27 @@ class LevelOneManager : LevelManager
         }
     }
 
+	void StartBenchmark(VariantMap& settings)
+	{
+		if(settings.Contains("WaveSchedule"))
+			WAVE_SCHEDULE_FILE = settings["WaveSchedule"].GetString();
+		if(settings.Contains("Invulnerable"))
+			playerInvulnerable_ = settings["Invulnerable"].GetBool();
+
+		//same setup as SetupLevel, but the game starts right away without music, countdown or background loading
+		SetLevelState(LS_OUTGAME);
+		LoadDisplayInterface();
+		LoadAttributeAnimations();
+		SetupScene();
+		CreateSkyBox();
+		CreateCameraAndLight();
+		SubscribeToEvents();
+		HandleCountFinished();
+	}
+
 	void SetupLevel()
 	{
 		LoadDisplayInterface();
-		LoadBackgroundResources();
 		LoadAttributeAnimations();
 		CreateGameControllers();
 		SetupScene();
@@ -303,6 +341,36 @@ class LevelOneManager : LevelManager
 	private void SetupScene()
 	{
 		scene.updateEnabled = false;
+
+		//tag and script queries are answered by the index instead of walking the scene
+		entityIndex_ = scene.entityIndex;
+
+		//sound effects play on a fixed set of reusable voices
+		scene.CreateComponent("SoundVoiceManager", LOCAL);
+
+		//bullets and explosions are prebuilt here and recycled during play
+		scene.CreateComponent("NodePool");
+		nodePool_ = scene.nodePool;
+		nodePool_.LoadDefinitions("Settings/NodePools.xml");
+
+		//bullets are moved and tested against the drones natively, in one pass per step
+		scene.CreateComponent("ProjectileSystem");
+		projectiles_ = scene.projectiles;
+
+		if(USE_NATIVE_SWARM)
+		{
+			scene.CreateComponent("DroneSwarmSystem");
+			droneSwarm_ = scene.droneSwarm;
+		}
+		else
+		{
+			scene.PreloadPrefab(DRONE_OBJECT_FILE);
+		}
+
+		//spawns into the drone swarm when there is one
+		scene.CreateComponent("WaveScheduler");
+		waves_ = scene.waveScheduler;
+		waves_.LoadSchedule(WAVE_SCHEDULE_FILE);
 	}
 
     private void CreateSkyBox()
@@ -323,6 +391,14 @@ class LevelOneManager : LevelManager
 		//Load the various UI Elements
 		healthFillSprite_ = displayRoot_.GetChild("HealthFill", true);
 		radarScreenBase_ = displayRoot_.GetChild("RadarScreenBase");
+
+		//drone blips are drawn natively and follow the rotation of the radar base
+		radar_ = CreateRadarDisplay(radarScreenBase_);
+		radar_.FitToParent();
+		radar_.texture = cache.GetResource("Texture2D", NORMAL_DRONE_SPRITE);
+		radar_.scale = SCENE_TO_UI_SCALE;
+		radar_.range = RADAR_RANGE;
+		radar_.SetTrackedScene(scene);
 		
 		targetSprite_ = displayRoot_.GetChild("Target");
 		
@@ -340,31 +416,6 @@ class LevelOneManager : LevelManager
 		displayRoot_.size = ui.root.size;
 	}
 	
-	void LoadBackgroundResources()
-	{
-		cache.BackgroundLoadResource("Model","Models/drone_body.mdl");
-		cache.BackgroundLoadResource("Model","Models/drone_arm.mdl");
-		cache.BackgroundLoadResource("Animation","Models/open_arm.ani");
-		cache.BackgroundLoadResource("Animation","Models/close_arm.ani");
-		
-		cache.BackgroundLoadResource("Texture2D", "Textures/explosion.png");
-		
-		cache.BackgroundLoadResource("ParticleEffect", "Particles/bullet_particle.xml");
-		cache.BackgroundLoadResource("ParticleEffect", "Particles/explosion.xml");
-		
-		cache.BackgroundLoadResource("Material","Materials/drone_arm.xml");
-		cache.BackgroundLoadResource("Material","Materials/drone_body.xml");
-		cache.BackgroundLoadResource("Material", "Materials/bullet_particle.xml");
-		cache.BackgroundLoadResource("Material", "Materials/explosion.xml");
-		
-		cache.BackgroundLoadResource("Texture2D", "Textures/drone_sprite.png");
-		cache.BackgroundLoadResource("Texture2D", "Textures/health_bar_green.png");
-		cache.BackgroundLoadResource("Texture2D", "Textures/health_bar_red.png");
-		cache.BackgroundLoadResource("Texture2D", "Textures/health_bar_yellow.png");
-		
-		cache.BackgroundLoadResource("Sound", "Sounds/boom1.wav");
-	}
-
 	void LoadAttributeAnimations()
 	{
 		textAnimation_ = cache.GetResource("ValueAnimation", "AttributeAnimations/GameStartCounterAnimation.xml");
@@ -384,6 +435,11 @@ class LevelOneManager : LevelManager
 		
 		cameraNode_.CreateComponent("SoundListener");
 		
+		if ( isHeadless_ )
+		{
+			return;
+		}
+
         viewport_ = Viewport(scene, cameraNode_.GetComponent("Camera"));
 
         renderer.viewports[0] = viewport_;
@@ -406,29 +462,34 @@ class LevelOneManager : LevelManager
 		playerNode_.CreateScriptObject("Scripts/GameObjects.as","PlayerObject");
 		
 		playerNode_.AddTag("player");
+		playerNode_.vars["Invulnerable"] = playerInvulnerable_;
+		radar_.SetCenterNode(playerNode_);
 
 		playerCameraNode.CreateComponent("SoundListener");
 		SetSoundListener(playerCameraNode);
 
-        viewport_.camera =  playerCameraNode.GetComponent("Camera") ;
+		if ( viewport_ !is null )
+		{
+			viewport_.camera =  playerCameraNode.GetComponent("Camera") ;
+		}
 		
 		playerDestroyed_ = false;
 	}
 	
 	void SubscribeToEvents()
 	{
-		SubscribeToEvent("PlayerHit","HandlePlayerHit");
-		SubscribeToEvent("DroneDestroyed", "HandleDroneDestroyed");
-		SubscribeToEvent("CountFinished", "HandleCountFinished");
-		SubscribeToEvent("SoundGenerated", "HandleSoundGenerated");
-		SubscribeToEvent("PlayerDestroyed", "HandlePlayerDestroyed");
-		SubscribeToEvent("PlayerHealthUpdate", "HandlePlayerHealthUpdate");
+		gameEvents.Subscribe(GE_PLAYERHIT, "HandlePlayerHit");
+		gameEvents.Subscribe(GE_DRONEDESTROYED, "HandleDroneDestroyed");
+		gameEvents.Subscribe(GE_COUNTFINISHED, "HandleCountFinished");
+		gameEvents.Subscribe(GE_PLAYERDESTROYED, "HandlePlayerDestroyed");
+		gameEvents.Subscribe(GE_PLAYERHEALTHUPDATE, "HandlePlayerHealthUpdate");
+		gameEvents.Subscribe(GE_PLAYERROTATION, "HandlePlayerRotation");
 		SubscribeToEvent(scene.physicsWorld, "PhysicsPreStep", "HandleFixedUpdate");
 	}
 	
 	void StartCounterToGame()
 	{
-        levelState_ = LS_COUNTDOWN;
+        SetLevelState(LS_COUNTDOWN);
 		statusText_.SetAttributeAnimation("Text", textAnimation_,WM_ONCE);
 	}
 	
@@ -436,8 +497,7 @@ class LevelOneManager : LevelManager
 	{
 		playerScoreMessageText_.text = "";
 		optionsInfoText_.text = "";
-		gamePhaseCounter_ = 0.0f;
-		droneSpawnCounter_ = 0.0f;
+		waves_.Restart();
 		playerScore_ = 0;
 		
 		SetSoundListener(cameraNode_);
@@ -449,11 +509,11 @@ class LevelOneManager : LevelManager
 	void InitiateGameOver()
 	{
 		scene.updateEnabled = false;
-		levelState_ = LS_OUTGAME;
+		SetLevelState(LS_OUTGAME);
 		
 		CleanupScene();
 		
-		if ( !isWeb_ )
+		if ( !isWeb_ && !isHeadless_ )
         {
 		    renderer.viewports[0].renderPath.SetEnabled("Blur",true);
         }
@@ -469,19 +529,32 @@ class LevelOneManager : LevelManager
 	void CleanupScene()
 	{
 		//Remove All Nodes with script object : Drones, Bullets and even the player
-		Array<Node@> scriptedNodes = scene.GetChildrenWithScript(true);
+		Array<Node@> scriptedNodes = entityIndex_.GetScriptedNodes();
 		for(uint i=0; i < scriptedNodes.length ; i++)
 		{
 			Node@ scriptNode = scriptedNodes[i];
-			Sprite@ nodeSprite = scriptNode.vars["Sprite"].GetPtr();
-			
-			if(nodeSprite !is null)
+
+			//pooled nodes are only returned to their pool
+			if(nodePool_ !is null && nodePool_.IsPooled(scriptNode))
 			{
-				nodeSprite.Remove();
+				nodePool_.Release(scriptNode);
+				continue;
 			}
-			
+
 			scriptNode.Remove();
 		}
+
+		if(droneSwarm_ !is null)
+		{
+			droneSwarm_.RemoveAllDrones();
+		}
+
+		if(projectiles_ !is null)
+		{
+			projectiles_.RemoveAllProjectiles();
+		}
+
+		scene.StopAllSounds();
 		
 		//Hide the enemy counter and player score texts
 		enemyCounterText_.text = "";
@@ -492,12 +565,12 @@ class LevelOneManager : LevelManager
 	{
 		//Show Warning
 		radarScreenBase_.SetAttributeAnimation("Color", damageAnimation_, WM_ONCE);
-		PlaySoundFX(cameraNode_,"Sounds/boom5.ogg");
+		scene.PlaySound("Sounds/boom5.ogg", cameraNode_.worldPosition, SOUND_PRIORITY_PLAYER_HIT);
 	}
 	
-	void HandleDroneDestroyed(StringHash eventType, VariantMap& eventData)
+	void HandleDroneDestroyed(const DroneDestroyedEvent&in event)
 	{
-		playerScore_ += eventData["DronePoint"].GetInt();
+		playerScore_ += event.dronePoint;
 		UpdateScoreDisplay();
 	}
 	
@@ -508,43 +581,41 @@ class LevelOneManager : LevelManager
 		cameraNode_.GetChild("DirectionalLight").enabled = false;
 		
 		scene.updateEnabled = true;
-		levelState_ = LS_INGAME;
+		SetLevelState(LS_INGAME);
 		
 		targetSprite_.visible = true;
 		enemyCounterText_.text = 0;
 		playerScoreText_.text = 0;
 		
-		if ( !isWeb_ )
+		if ( !isWeb_ && !isHeadless_ )
         {
 		    renderer.viewports[0].renderPath.SetEnabled("Blur",false);
         }
 	}
 	
-	void HandleSoundGenerated(StringHash eventType, VariantMap& eventData)
-	{
-		Node@ soundNode = eventData["SoundNode"].GetPtr();
-		String soundName = eventData["SoundName"].GetString();
-		
-		PlaySoundFX(soundNode, soundName);
-	}
-	
-	void HandlePlayerDestroyed(StringHash eventType, VariantMap& eventData)
+	void HandlePlayerDestroyed(const PlayerDestroyedEvent&in event)
 	{
 		playerDestroyed_ = true;
-		Vector3 camPosition = eventData["CamPosition"].GetVector3();
-		Quaternion camRotation = eventData["CamRotation"].GetQuaternion();
-		cameraNode_.worldRotation = camRotation;
-		cameraNode_.worldPosition = camPosition;
+		cameraNode_.worldRotation = event.camRotation;
+		cameraNode_.worldPosition = event.camPosition;
 		
 		SetViewportCamera(cameraNode_.GetComponent("Camera"));
 		cameraNode_.GetChild("DirectionalLight").enabled = true;
 		SetSoundListener(cameraNode_);
 	}
 	
-	void HandlePlayerHealthUpdate(StringHash eventType, VariantMap& eventData)
+	void HandlePlayerRotation(const PlayerRotationEvent&in event)
+	{
+		if(playerNode_ !is null)
+		{
+			radarScreenBase_.rotation = -playerNode_.worldRotation.yaw;
+		}
+	}
+	
+	void HandlePlayerHealthUpdate(const PlayerHealthUpdateEvent&in event)
 	{
 		//Update Health
-		float playerHealthFraction = eventData["CurrentHealthFraction"].GetFloat();
+		float playerHealthFraction = event.currentHealthFraction;
 		
 		int range = 512 - int( 512 * playerHealthFraction);
 		healthFillSprite_.imageRect = IntRect(range, 0, 512 + range, 64);
@@ -553,45 +624,23 @@ class LevelOneManager : LevelManager
 	
 	void HandleFixedUpdate(StringHash eventType, VariantMap& eventData)
 	{
+		perf.BeginScope("Level.FixedUpdate");
+
 		float timeStep = eventData["TimeStep"].GetFloat();
-		float droneSpawnRate = 0.0;
-			
-		gamePhaseCounter_ += timeStep;
-		if(gamePhaseCounter_ >= CRITICAL_PHASE)
-		{
-			droneSpawnRate = CRITICAL_PHASE_RATE;
-			gamePhaseCounter_ = CRITICAL_PHASE;		
-		}
-		else if(gamePhaseCounter_ >= MODERATE_PHASE) 
-		{
-			droneSpawnRate = MODERATE_PHASE_RATE;
-		}
-		else
-		{
-			droneSpawnRate = EASY_PHASE_RATE;
-		}
-		
-		droneSpawnCounter_ +=timeStep;
-		if(droneSpawnCounter_ >= droneSpawnRate)
-		{
-			if(GetDroneCount() < MAX_DRONE_COUNT)
-			{
-				SpawnDrone();
-				UpdateDroneSprites();
-				droneSpawnCounter_ = 0;
-			}
-		}
-		
-		spriteUpdateCounter_ += timeStep;
+
+		//the enemy counter also picks up the drones the wave scheduler spawned
+		counterUpdateCounter_ += timeStep;
 		
-		if(spriteUpdateCounter_ >= SPRITE_UPDATE_TIME)
+		if(counterUpdateCounter_ >= COUNTER_UPDATE_TIME)
 		{
-			UpdateDroneSprites();
-			spriteUpdateCounter_ = 0;
+			UpdateEnemyCounter();
+			counterUpdateCounter_ = 0;
 		}
+
+		perf.EndScope();
 	}
 	
-	private void HandleUpdate(VariantMap& eventData)
+	void HandleUpdate(VariantMap& eventData)
 	{
 		if(playerDestroyed_ && levelState_ == LS_INGAME)
 		{
@@ -647,19 +696,6 @@ class LevelOneManager : LevelManager
 		}
 	}
 	
-	void HandleMouseMove(VariantMap& eventData)
-	{
-		if(levelState_ != LS_INGAME)
-		{
-			return;
-		}
-		
-		int dx = eventData["DX"].GetInt();
-		int dy = eventData["DY"].GetInt();
-
-		RotatePlayer(dx, dy);
-	}
-
 	void HandleMouseClick()
 	{
 		if(levelState_ != LS_INGAME)
@@ -667,20 +703,13 @@ class LevelOneManager : LevelManager
 			return;
 		}
 		
-		//int mouseButton = eventData["Button"].GetInt();
-		
-		if(input.mouseButtonPress[MOUSEB_LEFT])
+		//the press comes through the player input so that recorded sessions can replay it
+		if(playerInput.firePressed)
 		{
 			Fire();
 		}
 	}
 	
-	void HandleSoundFinish(VariantMap& eventData)
-	{	
-		Node@ soundNode = eventData["Node"].GetPtr();
-		soundNode.RemoveComponent("SoundSource3D");
-	}
-	
 	void PlayBackgroundMusic()
 	{
 		if(backgroundMusic_ is null)
@@ -704,41 +733,6 @@ class LevelOneManager : LevelManager
         backgroundMusicSource_.Stop();
     }
 	
-	void PlaySoundFX(Node@ soundNode, String soundName )
-	{
-		SoundSource3D@ source = soundNode.CreateComponent("SoundSource3D");
-		
-		Sound@ sound = cache.GetResource("Sound", soundName);
-		source.SetDistanceAttenuation(0.2, 120, 0.1);
-		source.soundType = SOUND_EFFECT;
-		source.Play(sound);
-	}
-	
-	void SpawnDrone()
-	{
-		Node@ droneNode = scene.CreateChild();
-		
-		XMLFile@ file = cache.GetResource("XMLFile", "Objects/LowLevelDrone.xml");
-		droneNode.LoadXML(file.root);
-		
-		droneNode.vars["Sprite"] = CreateDroneSprite(NORMAL_DRONE_SPRITE);
-	}
-
-	Sprite@ CreateDroneSprite(String spriteTexture)
-	{
-		Texture2D@ droneSpriteTex = cache.GetResource("Texture2D", spriteTexture);
-		Sprite@ droneSprite = radarScreenBase_.CreateChild("Sprite");
-		
-		droneSprite.texture = droneSpriteTex;
-		droneSprite.SetSize(6,6);
-		droneSprite.SetAlignment(HA_CENTER, VA_CENTER);
-		droneSprite.SetHotSpot(3,3);
-		droneSprite.blendMode = BLEND_ALPHA;
-		droneSprite.priority = 1;
-		
-		return droneSprite;
-	}
-	
 	void UpdateHealthTexture(float healthFraction)
 	{
 		if(healthFraction > 0.5)
@@ -755,24 +749,11 @@ class LevelOneManager : LevelManager
 		}
 	}
 	
-	void UpdateDroneSprites()
+	void UpdateEnemyCounter()
 	{
-		Array<Node@> scriptNodes = scene.GetChildrenWithTag("drone",true);
-		
-		for(uint i=0; i < scriptNodes.length ; i++)
-		{
-			Node@ droneNode = scriptNodes[i];
-			Sprite@ nodeSprite = droneNode.vars["Sprite"].GetPtr();
-			
-			if(nodeSprite !is null)
-			{
-				Vector3 relativePos = droneNode.worldPosition - playerNode_.worldPosition ;
-				nodeSprite.position = Vector2(relativePos.x, -(relativePos.z))* SCENE_TO_UI_SCALE;
-			}
-		
-		}
-		
-		enemyCounterText_.text = scriptNodes.length;;
+		perf.BeginScope("Level.UpdateEnemyCounter");
+		enemyCounterText_.text = GetDroneCount();
+		perf.EndScope();
 	}
 
 	void UpdateScoreDisplay()
@@ -782,17 +763,12 @@ class LevelOneManager : LevelManager
 	 
 	void RotatePlayer(int dx, int dy)
 	{
-		VariantMap eventData;
-		eventData["DX"] = dx;
-		eventData["DY"] = dy;
-		SendEvent("PlayerRotation", eventData);
-		
-		radarScreenBase_.rotation = -playerNode_.worldRotation.yaw;
+		playerInput.AddLookDelta(dx, dy);
 	}
 
 	void Fire()
 	{	
-		SendEvent("ActivateWeapon");
+		gameEvents.Post(GE_ACTIVATEWEAPON);
 	}
 	
 	void ToggleGamePause()
@@ -802,12 +778,12 @@ class LevelOneManager : LevelManager
 		if(scene.updateEnabled)
 		{
 			statusText_.text = "";
-			levelState_ = LS_INGAME;
+			SetLevelState(LS_INGAME);
 		}
 		else
 		{
 			statusText_.text = "PAUSED";
-			levelState_ = LS_PAUSED;
+			SetLevelState(LS_PAUSED);
 		}
 		
 		targetSprite_.visible = scene.updateEnabled;
@@ -815,15 +791,14 @@ class LevelOneManager : LevelManager
 	
 	int GetDroneCount()
 	{
-		Array<Node@> scriptNodes = scene.GetChildrenWithTag("drone",true);
-		return scriptNodes.length;
+		return entityIndex_.GetTaggedCount("drone");
 	}
 
 	// look for a config file to normalize the controller button functions.
 	// and set up the event handlers in case 1 joystick is connected
 	void CreateGameControllers()
 	{
-		if ( input.numJoysticks > 0 )  // is there a game controller plugged in?
+		if ( playerInput.numJoysticks > 0 )  // is there a game controller plugged in?
 		{
 		   myjoystick_.load_user_settings();
 		}
@@ -838,7 +813,7 @@ class LevelOneManager : LevelManager
 	// limit the number of steps moved, hopefully to improve the aiming.
 	void joystickUpdate ( int position )
 	{
-		if (input.numJoysticks == 0 || position == -1 || ( myjoystick_ is null ) ) return;
+		if (playerInput.numJoysticks == 0 || position == -1 || ( myjoystick_ is null ) ) return;
 
 		// reset the counter if the controller emits 0, or the button pressed changes
 		if ( position == 0 || myjoystick_.updatevalue_ != position )
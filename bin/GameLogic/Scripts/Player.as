@@ -47,8 +47,7 @@ class PlayerObject : ScriptObject
 	
 	void DelayedStart()
 	{
-		SubscribeToEvent("ActivateWeapon", "HandleActivateWeapon");
-		SubscribeToEvent("PlayerRotation", "HandlePlayerRotation");
+		gameEvents.Subscribe(GE_ACTIVATEWEAPON, "HandleActivateWeapon");
 		Initialise();
 		UpdateHealth(100);
 	}
@@ -61,6 +60,9 @@ class PlayerObject : ScriptObject
 		playerColShape.SetSphere(2);
 		SetWeapon(OrdinaryWeapon(node.GetChild("CameraNode")));
 		
+		//the look input of each frame is applied natively to the player and its camera
+		node.CreateComponent("PlayerLook");
+		
 		Node@ cameraNode = node.GetChild("CameraNode");
 		
 		Node@ lightNode = cameraNode.CreateChild("DirectionalLight");
@@ -74,25 +76,16 @@ class PlayerObject : ScriptObject
 		weapon_.Fire();
 	}
 	
-	void HandlePlayerRotation(StringHash eventType, VariantMap& eventData)
-	{
-		int dx = eventData["DX"].GetInt();
-		int dy = eventData["DY"].GetInt();
-		
-		Node@ cameraNode = node.GetChild("CameraNode");
-		
-		float playerYaw = node.rotation.yaw + (dx * 0.25f);
-		float camPitch = cameraNode.rotation.pitch + (dy * 0.25f);
-		
-		camPitch = Clamp(camPitch, -20.0f, 70.0f);
-		
-		cameraNode.rotation = Quaternion(camPitch, 0.0f, 0.0f);
-		node.rotation = Quaternion(0.0f, playerYaw, 0.0f);
-	}
-	
 	void OnHit(float damagePoint)
 	{
-		SendEvent("PlayerHit");
+		gameEvents.Post(GE_PLAYERHIT);
+
+		//benchmarks may keep the player alive to hold the load steady
+		if(node.vars["Invulnerable"].GetBool())
+		{
+			return;
+		}
+
 		UpdateHealth(-damagePoint);
 
 		if(currentHealth_ == 0 )
@@ -100,16 +93,10 @@ class PlayerObject : ScriptObject
 			//if health is equal to or below zero notify that the player
 			//has been destroyed
 			currentHealth_ = 0.0f;
-			VariantMap eventData;
 			
 			Node@ cameraNode = node.GetChild("CameraNode");
-			eventData["CamPosition"] = cameraNode.worldPosition;
-			eventData["CamRotation"] = cameraNode.worldRotation;
-			
-			eventData["PlayerPosition"] = node.worldPosition;
-			eventData["PlayerRotation"] = node.worldRotation;
-			
-			SendEvent("PlayerDestroyed",eventData);
+			gameEvents.Post(PlayerDestroyedEvent(cameraNode.worldPosition, cameraNode.worldRotation,
+				node.worldPosition, node.worldRotation));
 			
 			node.GetChild("CameraNode").GetChild("DirectionalLight").enabled = false;
 		}
@@ -148,9 +135,7 @@ class PlayerObject : ScriptObject
 		}
 		
 		float healthFraction = currentHealth_ / maximumHealth_;
-		VariantMap eventData;
-		eventData["CurrentHealthFraction"] = healthFraction;
-		SendEvent("PlayerHealthUpdate", eventData);
+		gameEvents.Post(PlayerHealthUpdateEvent(healthFraction));
 	}
 	
 	void SetWeapon(Weapon@ weapon)
@@ -41,12 +41,13 @@ class OrdinaryWeapon : Weapon
 {
 	void Fire()
 	{	
+		perf.BeginScope("Weapon.Fire");
+
 		SpawnBullet(true);
 		SpawnBullet(false);
-		VariantMap eventData;
-		eventData["SoundNode"] = refNode_;
-		eventData["SoundName"] = "Sounds/boom1.wav";
-		SendEvent("SoundGenerated", eventData);
+		refNode_.scene.PlaySound("Sounds/boom1.wav", refNode_.worldPosition, SOUND_PRIORITY_WEAPON);
+
+		perf.EndScope();
 	}
 	
 	OrdinaryWeapon(Node@ refNode)
@@ -56,13 +57,28 @@ class OrdinaryWeapon : Weapon
 
 	void SpawnBullet(bool first)
 	{
-		Node@ bulletNode = refNode_.scene.CreateChild();
-		bulletNode.worldPosition = refNode_.worldPosition;
-		bulletNode.rotation = refNode_.worldRotation;
-		
 		float xOffSet = 0.3f * (first ? 1 : -1);
-		bulletNode.Translate(Vector3(xOffSet,-0.2,0));
+		Quaternion bulletRotation = refNode_.worldRotation;
+		Vector3 bulletPosition = refNode_.worldPosition + bulletRotation * Vector3(xOffSet,-0.2,0);
+		
+		ProjectileSystem@ projectiles = refNode_.scene.projectiles;
+		if(projectiles !is null)
+		{
+			projectiles.Fire(bulletPosition, bulletRotation);
+			return;
+		}
+		
+		NodePool@ nodePool = refNode_.scene.nodePool;
+		if(nodePool !is null && nodePool.Acquire("LowLevelBullet", bulletPosition, bulletRotation) !is null)
+		{
+			return;
+		}
+		
+		Node@ bulletNode = refNode_.scene.CreateChild();
+		bulletNode.worldPosition = bulletPosition;
+		bulletNode.rotation = bulletRotation;
 		
-		bulletNode.CreateScriptObject("Scripts/GameObjects.as", "LowLevelBullet");
+		Bullet@ bullet = cast<Bullet>(bulletNode.CreateScriptObject("Scripts/GameObjects.as", "LowLevelBullet"));
+		bullet.OnAcquired();
 	}
 }
@@ -0,0 +1,30 @@
+// Service worker served next to the multithreaded web build. Hosts that cannot send the cross-origin isolation
+// headers get them added to every same-origin response here, which lets the page use SharedArrayBuffer.
+
+self.addEventListener('install', () => self.skipWaiting());
+self.addEventListener('activate', event => event.waitUntil(self.clients.claim()));
+
+self.addEventListener('fetch', event => {
+    const request = event.request;
+    if (request.cache === 'only-if-cached' && request.mode !== 'same-origin') {
+        return;
+    }
+
+    event.respondWith(fetch(request).then(response => {
+        // opaque responses can not be modified
+        if (response.status === 0) {
+            return response;
+        }
+
+        const headers = new Headers(response.headers);
+        headers.set('Cross-Origin-Opener-Policy', 'same-origin');
+        headers.set('Cross-Origin-Embedder-Policy', 'require-corp');
+        headers.set('Cross-Origin-Resource-Policy', 'cross-origin');
+
+        return new Response(response.body, {
+            status: response.status,
+            statusText: response.statusText,
+            headers: headers
+        });
+    }));
+});